@@ -0,0 +1,465 @@
+#ifndef BENCHMARKCATALOG_H_
+#define BENCHMARKCATALOG_H_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "LineDecoder.h"
+
+/*
+ * @brief Header information of one benchmark file in a catalog.
+ *
+ * @details The path is relative to the catalog directory. Files without a .p line
+ * have -1 product terms. A count which is missing or malformed is -1, such entries
+ * are indexed but don't match the default input and output bounds of a filter.
+ * The content hash is the 64 bit FNV-1a hash of the file.
+ */
+struct CatalogEntry {
+	std::string path;
+	std::string model_name;
+	std::string type;
+
+	int num_inputs = -1;
+	int num_outputs = -1;
+	int64_t num_product_terms = -1;
+	int format = -1;
+
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	uint64_t hash = 0;
+};
+
+/*
+ * @brief Selection of catalog entries, every unset bound matches all files.
+ *
+ * @details The ranges are inclusive. The formats are a bit mask of
+ * 1 << BenchmarkCatalog::PLU, 1 << BenchmarkCatalog::PLA and 1 << BenchmarkCatalog::TT.
+ * The model name matches if it contains the given string.
+ */
+struct CatalogFilter {
+	int min_inputs = 0;
+	int max_inputs = std::numeric_limits<int>::max();
+	int min_outputs = 0;
+	int max_outputs = std::numeric_limits<int>::max();
+	int64_t min_product_terms = -1;
+	int64_t max_product_terms = std::numeric_limits<int64_t>::max();
+	int formats = 7;
+	std::string model_name;
+};
+
+/*
+ * @brief Index of the headers of all benchmark files below a directory.
+ *
+ * @details Building the catalog reads every header in a single pass that stops at the
+ * first body row, and hashes the file contents once. The entries are stored in an
+ * index file, by default ".benchmark-index" in the directory, with one tab separated
+ * line per file:
+ *
+ * 		path  model  type  inputs  outputs  product terms  format  size  mtime  hash
+ *
+ * When the catalog is loaded again, only the files whose size or modification time
+ * differ from the index are scanned, new files are added and deleted files are
+ * dropped. Loading an unchanged corpus therefore only lists the directory.
+ */
+class BenchmarkCatalog {
+private:
+	static constexpr const char *INDEX_NAME = ".benchmark-index";
+	static constexpr const char *INDEX_VERSION = "# benchmark-index 1";
+
+	std::filesystem::path directory;
+	std::filesystem::path index_path;
+
+	std::vector<CatalogEntry> entries;
+
+	bool read_index();
+	void write_index() const;
+
+	static bool parse_entry(const std::string &p_line, CatalogEntry &p_entry);
+	static int64_t modification_time(const std::filesystem::path &p_path);
+
+public:
+	// Constants for the status of the file format
+	static const int PLU = 0;
+	static const int PLA = 1;
+	static const int TT = 2;
+
+	BenchmarkCatalog() = default;
+	virtual ~BenchmarkCatalog() = default;
+
+	static int file_format(const std::filesystem::path &p_path);
+	static uint64_t content_hash(const std::filesystem::path &p_path);
+	static void scan_header(const std::filesystem::path &p_path, CatalogEntry &p_entry);
+
+	int load(const std::string &p_directory, const std::string &p_index_path = "");
+
+	const std::vector<CatalogEntry>& get_entries() const;
+	const CatalogEntry* find(const std::string &p_path) const;
+
+	std::vector<const CatalogEntry*> select(const CatalogFilter &p_filter) const;
+
+	template<class F>
+	std::vector<const CatalogEntry*> select_if(F p_predicate) const;
+};
+
+/**
+ * @brief Returns the format of a benchmark file by its extension, or -1.
+ */
+inline int BenchmarkCatalog::file_format(const std::filesystem::path &p_path) {
+
+	std::string extension = p_path.extension();
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	if (extension == ".plu") {
+		return PLU;
+	} else if (extension == ".pla") {
+		return PLA;
+	} else if (extension == ".tt") {
+		return TT;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Computes the 64 bit FNV-1a hash of the contents of a file.
+ */
+inline uint64_t BenchmarkCatalog::content_hash(const std::filesystem::path &p_path) {
+
+	const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+	const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+	std::ifstream ifs(p_path, std::ifstream::in | std::ifstream::binary);
+
+	if (!ifs.is_open()) {
+		throw std::runtime_error("Cannot open benchmark file!");
+	}
+
+	std::vector<char> buffer(1 << 20);
+	uint64_t hash = FNV_OFFSET;
+
+	while (ifs) {
+		ifs.read(buffer.data(), buffer.size());
+		std::streamsize count = ifs.gcount();
+
+		for (std::streamsize i = 0; i < count; i++) {
+			hash ^= (unsigned char) buffer[i];
+			hash *= FNV_PRIME;
+		}
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Reads the header keywords of a file in one pass.
+ *
+ * @details The scan stops at the first row of the body, so the cost does not depend
+ * on the size of the file. A malformed .i, .o or .p value leaves the count at -1
+ * instead of throwing, so that one broken file doesn't abort loading the corpus.
+ */
+inline void BenchmarkCatalog::scan_header(const std::filesystem::path &p_path,
+		CatalogEntry &p_entry) {
+
+	std::ifstream ifs(p_path, std::ifstream::in);
+
+	if (!ifs.is_open()) {
+		throw std::runtime_error("Cannot open benchmark file!");
+	}
+
+	std::string line;
+
+	while (std::getline(ifs, line)) {
+
+		if (LineDecoder::is_body_line(line)) {
+			break;
+		}
+
+		std::stringstream sstream(line);
+		std::string keyword;
+		std::string value;
+
+		sstream >> keyword >> value;
+
+		try {
+			if (keyword == ".model") {
+				p_entry.model_name = value;
+			} else if (keyword == ".type") {
+				p_entry.type = value;
+			} else if (keyword == ".i") {
+				p_entry.num_inputs = std::stoi(value);
+			} else if (keyword == ".o") {
+				p_entry.num_outputs = std::stoi(value);
+			} else if (keyword == ".p") {
+				p_entry.num_product_terms = std::stoll(value);
+			}
+		} catch (const std::logic_error&) {
+			// std::invalid_argument or std::out_of_range, the count stays unknown
+		}
+	}
+}
+
+/**
+ * @brief Returns the modification time of a file in ticks of the file clock.
+ */
+inline int64_t BenchmarkCatalog::modification_time(
+		const std::filesystem::path &p_path) {
+	return std::filesystem::last_write_time(p_path).time_since_epoch().count();
+}
+
+/**
+ * @brief Parses one line of the index file, returns false if it is malformed.
+ */
+inline bool BenchmarkCatalog::parse_entry(const std::string &p_line,
+		CatalogEntry &p_entry) {
+
+	std::vector<std::string> fields;
+	std::stringstream sstream(p_line);
+	std::string field;
+
+	while (std::getline(sstream, field, '\t')) {
+		fields.push_back(field);
+	}
+
+	if (fields.size() != 10) {
+		return false;
+	}
+
+	try {
+		p_entry.path = fields[0];
+		p_entry.model_name = fields[1];
+		p_entry.type = fields[2];
+		p_entry.num_inputs = std::stoi(fields[3]);
+		p_entry.num_outputs = std::stoi(fields[4]);
+		p_entry.num_product_terms = std::stoll(fields[5]);
+		p_entry.format = std::stoi(fields[6]);
+		p_entry.size = std::stoull(fields[7]);
+		p_entry.mtime = std::stoll(fields[8]);
+		p_entry.hash = std::stoull(fields[9], nullptr, 16);
+	} catch (const std::exception&) {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Reads the entries of the index file, returns false if there is no valid index.
+ */
+inline bool BenchmarkCatalog::read_index() {
+
+	this->entries.clear();
+
+	std::ifstream ifs(this->index_path, std::ifstream::in);
+	std::string line;
+
+	if (!ifs.is_open() || !std::getline(ifs, line) || line != INDEX_VERSION) {
+		return false;
+	}
+
+	while (std::getline(ifs, line)) {
+		CatalogEntry entry;
+
+		if (!parse_entry(line, entry)) {
+			this->entries.clear();
+			return false;
+		}
+
+		this->entries.push_back(std::move(entry));
+	}
+
+	return true;
+}
+
+/**
+ * @brief Writes the entries to a temporary file which then replaces the index.
+ */
+inline void BenchmarkCatalog::write_index() const {
+
+	std::filesystem::path temp_path = this->index_path;
+	temp_path += ".tmp";
+
+	std::ofstream ofs(temp_path, std::ofstream::out | std::ofstream::trunc);
+
+	if (!ofs.is_open()) {
+		throw std::runtime_error("Cannot write benchmark index!");
+	}
+
+	ofs << INDEX_VERSION << "\n";
+
+	for (const CatalogEntry &entry : this->entries) {
+		ofs << entry.path << "\t" << entry.model_name << "\t" << entry.type << "\t"
+				<< entry.num_inputs << "\t" << entry.num_outputs << "\t"
+				<< entry.num_product_terms << "\t" << entry.format << "\t"
+				<< entry.size << "\t" << entry.mtime << "\t"
+				<< std::hex << entry.hash << std::dec << "\n";
+	}
+
+	ofs.close();
+
+	if (ofs.fail()) {
+		throw std::runtime_error("Cannot write benchmark index!");
+	}
+
+	std::filesystem::rename(temp_path, this->index_path);
+}
+
+/**
+ * @brief Loads the catalog of a directory and updates it incrementally.
+ *
+ * @details The directory is listed recursively. Files which are not in the index or
+ * whose size or modification time changed are scanned again. The index file is only
+ * rewritten if an entry changed.
+ *
+ * @param p_directory Root directory of the benchmark files
+ * @param p_index_path Path of the index file, by default .benchmark-index in the directory
+ *
+ * @return Number of files which have been scanned
+ */
+inline int BenchmarkCatalog::load(const std::string &p_directory,
+		const std::string &p_index_path) {
+
+	namespace fs = std::filesystem;
+
+	this->directory = p_directory;
+	this->index_path = (p_index_path.length() > 0) ?
+			fs::path(p_index_path) : this->directory / INDEX_NAME;
+
+	if (!fs::is_directory(this->directory)) {
+		throw std::runtime_error("Benchmark directory doesn't exist!");
+	}
+
+	bool changed = !this->read_index();
+
+	std::unordered_map<std::string, size_t> indexed;
+
+	for (size_t i = 0; i < this->entries.size(); i++) {
+		indexed[this->entries[i].path] = i;
+	}
+
+	std::vector<CatalogEntry> current;
+	int num_scanned = 0;
+
+	for (const fs::directory_entry &file : fs::recursive_directory_iterator(
+			this->directory, fs::directory_options::skip_permission_denied)) {
+
+		if (!file.is_regular_file() || file_format(file.path()) < 0) {
+			continue;
+		}
+
+		std::string path = file.path().lexically_relative(this->directory).generic_string();
+
+		// Such paths can't be stored in the index
+		if (path.find_first_of("\t\n") != std::string::npos) {
+			continue;
+		}
+
+		uint64_t size = file.file_size();
+		int64_t mtime = modification_time(file.path());
+
+		auto it = indexed.find(path);
+
+		if (it != indexed.end() && this->entries[it->second].size == size
+				&& this->entries[it->second].mtime == mtime) {
+			current.push_back(std::move(this->entries[it->second]));
+			continue;
+		}
+
+		CatalogEntry entry;
+		entry.path = path;
+		entry.format = file_format(file.path());
+		entry.size = size;
+		entry.mtime = mtime;
+
+		scan_header(file.path(), entry);
+		entry.hash = content_hash(file.path());
+
+		current.push_back(std::move(entry));
+		num_scanned++;
+	}
+
+	changed = changed || num_scanned > 0 || current.size() != this->entries.size();
+
+	std::sort(current.begin(), current.end(),
+			[](const CatalogEntry &a, const CatalogEntry &b) {
+				return a.path < b.path;
+			});
+
+	this->entries = std::move(current);
+
+	if (changed) {
+		this->write_index();
+	}
+
+	return num_scanned;
+}
+
+/**
+ * @brief Returns all entries, sorted by path.
+ */
+inline const std::vector<CatalogEntry>& BenchmarkCatalog::get_entries() const {
+	return this->entries;
+}
+
+/**
+ * @brief Returns the entry of a path relative to the directory, or nullptr.
+ */
+inline const CatalogEntry* BenchmarkCatalog::find(const std::string &p_path) const {
+
+	auto it = std::lower_bound(this->entries.begin(), this->entries.end(), p_path,
+			[](const CatalogEntry &a, const std::string &b) {
+				return a.path < b;
+			});
+
+	if (it == this->entries.end() || it->path != p_path) {
+		return nullptr;
+	}
+
+	return &(*it);
+}
+
+/**
+ * @brief Returns the entries which match all bounds of the filter.
+ */
+inline std::vector<const CatalogEntry*> BenchmarkCatalog::select(
+		const CatalogFilter &p_filter) const {
+
+	return this->select_if([&p_filter](const CatalogEntry &e) {
+		return e.num_inputs >= p_filter.min_inputs
+				&& e.num_inputs <= p_filter.max_inputs
+				&& e.num_outputs >= p_filter.min_outputs
+				&& e.num_outputs <= p_filter.max_outputs
+				&& e.num_product_terms >= p_filter.min_product_terms
+				&& e.num_product_terms <= p_filter.max_product_terms
+				&& ((p_filter.formats >> e.format) & 1)
+				&& e.model_name.find(p_filter.model_name) != std::string::npos;
+	});
+}
+
+/**
+ * @brief Returns the entries for which the predicate holds.
+ *
+ * @tparam F Callable with the signature bool(const CatalogEntry &entry)
+ */
+template<class F>
+std::vector<const CatalogEntry*> BenchmarkCatalog::select_if(F p_predicate) const {
+
+	std::vector<const CatalogEntry*> result;
+
+	for (const CatalogEntry &entry : this->entries) {
+		if (p_predicate(entry)) {
+			result.push_back(&entry);
+		}
+	}
+
+	return result;
+}
+
+#endif /* BENCHMARKCATALOG_H_ */
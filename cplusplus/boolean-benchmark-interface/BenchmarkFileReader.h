@@ -13,9 +13,14 @@
 #include <utility>
 #include <algorithm>
 #include <cstring>
+#include <atomic>
+#include <mutex>
 
 #include "TruthTable.h"
 #include "Minterm.h"
+#include "LineDecoder.h"
+#include "Cover.h"
+#include "ParallelFor.h"
 
 /*
  *  @brief The generic class BenchmarkFileReader provides methods for reading PLU as well as
@@ -42,6 +47,7 @@ private:
 	std::string line;
 
 	TruthTable<T> table;
+	Cover cover;
 
 	int num_inputs;
 	int num_outputs;
@@ -51,6 +57,11 @@ private:
 	int header_size;
 
 	std::string model_name;
+	std::string type;
+
+	bool keep_rows;
+	bool keep_cover;
+	int num_threads;
 
 	const int PLU = 0;
 	const int PLA = 1;
@@ -58,6 +69,11 @@ private:
 
 	void validate_file(std::string file_path);
 	int file_format(std::string file_path);
+	void throw_parse_error(std::string format, uint64_t row, int column);
+	void check_body_end(std::istream &stream, std::string format, uint64_t rows);
+	void read_tt_body_parallel(std::string file_path,
+			std::streamoff body_offset, uint64_t rows,
+			std::vector<WordVector> &words);
 
 public:
 	BenchmarkFileReader();
@@ -74,6 +90,7 @@ public:
 	void read_num_inputs();
 	void read_num_outputs();
 	void read_num_product_terms();
+	void read_type();
 	void read_names(std::string keyword, std::vector<std::string> &names);
 	void read_input_names();
 	void read_output_names();
@@ -81,10 +98,23 @@ public:
 	void print_truth_table();
 	void print_header();
 
+	void set_keep_rows(bool p_keep_rows);
+	void set_keep_cover(bool p_keep_cover);
+	void set_num_threads(int p_num_threads);
+	void set_allocation_policy(const AllocationPolicy &p_policy);
+
+	int get_num_inputs() const;
+	int get_num_outputs() const;
+	int get_num_product_terms() const;
+	const std::string& get_model_name() const;
+	const std::string& get_type() const;
+
 	const std::vector<std::vector<T> >& get_compressed_inputs() const;
 	const std::vector<std::vector<T> >& get_compressed_outputs() const;
 
 	const TruthTable<T>& get_truth_table() const;
+	TruthTable<T> take_truth_table();
+	const Cover& get_cover() const;
 
 	std::vector<std::vector<char>>* generate_input_table();
 
@@ -97,6 +127,108 @@ BenchmarkFileReader<T>::BenchmarkFileReader() {
 	this->num_chunks = -1;
 	this->num_product_terms = -1;
 	this->model_name = "";
+	this->type = "";
+	this->keep_rows = true;
+	this->keep_cover = false;
+	this->num_threads = 1;
+}
+
+/**
+ * @brief Sets whether the row-major 2D vectors of the truth table are kept.
+ *
+ * @details The output columns are always packed when a TT, PLA or PLU file is
+ * read. Disabling the row-major vectors reduces the memory of large tables to the
+ * packed columns. For PLU files the row-major vectors hold the compressed chunks
+ * and the table is only marked as compressed if they are kept. The row-major
+ * inputs are not owned by the table but shared by all tables with the same number
+ * of inputs, see InputPatternCache::rows().
+ *
+ * @param p_keep_rows Keep the row-major vectors after reading
+ */
+template<class T>
+void BenchmarkFileReader<T>::set_keep_rows(bool p_keep_rows) {
+	this->keep_rows = p_keep_rows;
+}
+
+/**
+ * @brief Sets whether the ON-set cubes of a PLA file are kept as cover.
+ *
+ * @details The cover can be edited cube by cube with an EditableCover instead of
+ * reading the file again after each edit.
+ *
+ * @param p_keep_cover Keep the cover after reading, see get_cover()
+ */
+template<class T>
+void BenchmarkFileReader<T>::set_keep_cover(bool p_keep_cover) {
+	this->keep_cover = p_keep_cover;
+}
+
+/**
+ * @brief Sets the number of threads which parse the body of a TT file.
+ *
+ * @details With more than one thread, the body is split into ranges of rows which
+ * are read and parsed concurrently. A value of 0 selects the hardware concurrency.
+ *
+ * @param p_num_threads Number of threads, 1 for sequential parsing
+ */
+template<class T>
+void BenchmarkFileReader<T>::set_num_threads(int p_num_threads) {
+	this->num_threads = p_num_threads;
+}
+
+/**
+ * @brief Sets the allocation policy of the output columns of the table.
+ *
+ * @details With the FIRST_TOUCH placement, num_threads and bind_thread should
+ * match the pinned threads of the evaluation, so that each evaluator thread works on
+ * a slice of rows whose pages reside on its node.
+ *
+ * @see AllocationPolicy
+ */
+template<class T>
+void BenchmarkFileReader<T>::set_allocation_policy(
+		const AllocationPolicy &p_policy) {
+	this->table.set_allocation_policy(p_policy);
+}
+
+/**
+ * @brief Returns the number of inputs given in the header.
+ */
+template<class T>
+int BenchmarkFileReader<T>::get_num_inputs() const {
+	return this->num_inputs;
+}
+
+/**
+ * @brief Returns the number of outputs given in the header.
+ */
+template<class T>
+int BenchmarkFileReader<T>::get_num_outputs() const {
+	return this->num_outputs;
+}
+
+/**
+ * @brief Returns the number of product terms given in the header.
+ */
+template<class T>
+int BenchmarkFileReader<T>::get_num_product_terms() const {
+	return this->num_product_terms;
+}
+
+/**
+ * @brief Returns the model name given in the header.
+ */
+template<class T>
+const std::string& BenchmarkFileReader<T>::get_model_name() const {
+	return this->model_name;
+}
+
+/**
+ * @brief Returns the type of the PLA file given in the header, or an empty string.
+ */
+template<class T>
+const std::string& BenchmarkFileReader<T>::get_type() const {
+	return this->type;
 }
 
 /**
@@ -118,6 +250,32 @@ const TruthTable<T>& BenchmarkFileReader<T>::get_truth_table() const {
 	return this->table;
 }
 
+/**
+ * @brief Moves the table of the last file out of the reader.
+ *
+ * @details Unlike a copy of get_truth_table(), the packed columns are not
+ * duplicated, so the peak memory stays at one table. The reader keeps an empty
+ * table with the same allocation policy for the next file.
+ */
+template<class T>
+TruthTable<T> BenchmarkFileReader<T>::take_truth_table() {
+	TruthTable<T> taken = std::move(this->table);
+
+	this->table = TruthTable<T>();
+	this->table.set_allocation_policy(taken.get_allocation_policy());
+
+	return taken;
+}
+
+/**
+ * @brief Returns the ON-set cubes of the last PLA file, one cube per product term
+ * with at least one '1' output. Requires set_keep_cover(true) before reading.
+ */
+template<class T>
+const Cover& BenchmarkFileReader<T>::get_cover() const {
+	return this->cover;
+}
+
 /**
  * @brief Validate the benchmark file
  *
@@ -152,6 +310,48 @@ void BenchmarkFileReader<T>::validate_file(std::string file_path) {
 
 }
 
+/**
+ * @brief Throws an exception which reports the position of a malformed body row.
+ *
+ * @param format Name of the file format
+ * @param row Zero-based index of the row within the body
+ * @param column Zero-based column of the error
+ */
+template<class T>
+void BenchmarkFileReader<T>::throw_parse_error(std::string format, uint64_t row,
+		int column) {
+	throw std::runtime_error(
+			"Error while reading " + format + " file at line "
+					+ std::to_string(this->header_size + row + 1) + ", column "
+					+ std::to_string(column + 1) + "!");
+}
+
+/**
+ * @brief Checks that no body rows follow the last row of a table.
+ *
+ * @details Empty lines and keywords such as .e may follow the body.
+ *
+ * @param stream Stream positioned after the last row
+ * @param format Name of the file format
+ * @param rows Number of rows of the body
+ */
+template<class T>
+void BenchmarkFileReader<T>::check_body_end(std::istream &stream,
+		std::string format, uint64_t rows) {
+
+	std::string line;
+
+	while (std::getline(stream, line)) {
+		if (LineDecoder::is_body_line(line)) {
+			this->throw_parse_error(format, rows, 0);
+		}
+
+		if (line.size() > 0) {
+			return;
+		}
+	}
+}
+
 /**
  * @brief Checks and returns the format of the benchmark file.
  *
@@ -163,7 +363,29 @@ void BenchmarkFileReader<T>::validate_file(std::string file_path) {
  * @return File format status of the file:
  * 		   0 : PLU
  * 		   1 : PLA
+ * 		   2 : TT
  */
+template<class T>
+int BenchmarkFileReader<T>::file_format(std::string file_path) {
+
+	// Extract the file extension
+	std::string extension = std::filesystem::path(file_path).extension();
+
+	// Convert to lower case
+	std::transform(extension.begin(), extension.end(), extension.begin(),
+			::tolower);
+
+	if (extension == ".plu") {
+		return PLU;
+	} else if (extension == ".pla") {
+		return PLA;
+	} else if (extension == ".tt") {
+		return TT;
+	} else {
+		throw std::runtime_error("Invalid file format!");
+	}
+}
+
 /**
  * @param
  */
@@ -189,28 +411,38 @@ void BenchmarkFileReader<T>::close_file() {
 	ifs.close();
 }
 
+/**
+ * @brief Reads the header and the body of a benchmark file.
+ *
+ * @details The reading procedure is chosen by the format of the file.
+ * The file is closed afterwards.
+ *
+ * @param file_path Given path for the benchmark file
+ */
 template<class T>
 void BenchmarkFileReader<T>::read_file(std::string file_path) {
 
+	if (ifs.is_open()) {
+		this->close_file();
+	}
+
 	this->open_file(file_path);
 
 	if (ifs.is_open()) {
 		this->read_header();
 
-		char c;
-		int rows;
-
-		std::string str;
+		int format = this->file_format(file_path);
 
-		T input;
-		T output;
-
-		// Vectors for the data of each row
-		std::vector<T> row_inputs;
-		std::vector<T> row_outputs;
+		if (format == TT) {
+			this->read_tt_file(file_path);
+		} else if (format == PLA) {
+			this->read_pla_file(file_path);
+		} else {
+			this->close_file();
+			this->read_plu_file(file_path);
+		}
 
-		// Clear the table from potential previous data, reset the compressed status
-		table.reset();
+		this->close_file();
 	} else {
 		throw std::runtime_error("Benchmark file is not open!");
 	}
@@ -233,6 +465,12 @@ std::string BenchmarkFileReader<T>::read_keyword(std::string keyword) {
 		std::string line;
 
 		while (std::getline(ifs, line)) {
+
+			// The header ends with the first row of the body
+			if (LineDecoder::is_body_line(line)) {
+				break;
+			}
+
 			if (line.find(keyword) != std::string::npos) {
 
 				std::stringstream sstream(line);
@@ -263,6 +501,7 @@ std::string BenchmarkFileReader<T>::read_keyword(std::string keyword) {
 template<class T>
 void BenchmarkFileReader<T>::read_model_name() {
 	this->model_name = this->read_keyword(".model");
+	this->table.set_model_name(this->model_name);
 }
 
 /**
@@ -298,6 +537,20 @@ void BenchmarkFileReader<T>::read_num_product_terms() {
 	this->num_product_terms = (s != "") ? std::stoi(s) : -1;
 }
 
+/**
+ * @brief Reads the .type keyword of PLA files, which is one of f, fd, fr and fdr.
+ */
+template<class T>
+void BenchmarkFileReader<T>::read_type() {
+
+	this->type = this->read_keyword(".type");
+
+	if (this->type != "" && this->type != "f" && this->type != "fd"
+			&& this->type != "fr" && this->type != "fdr") {
+		throw std::runtime_error("Unknown PLA type: " + this->type);
+	}
+}
+
 /**
  *
  */
@@ -313,6 +566,12 @@ void BenchmarkFileReader<T>::read_names(std::string keyword,
 		std::string line;
 
 		while (std::getline(ifs, line)) {
+
+			// The header ends with the first row of the body
+			if (LineDecoder::is_body_line(line)) {
+				break;
+			}
+
 			if (line.find(keyword) != std::string::npos) {
 
 				std::stringstream sstream(line);
@@ -323,7 +582,10 @@ void BenchmarkFileReader<T>::read_names(std::string keyword,
 				}
 			}
 		}
-		names.erase(names.begin());
+
+		if (names.size() > 0) {
+			names.erase(names.begin());
+		}
 
 	} else {
 		throw std::runtime_error("Benchmark file is not open!");
@@ -377,6 +639,10 @@ void BenchmarkFileReader<T>::print_header() {
 		std::cout << "Product terms: " << this->num_product_terms << std::endl;
 	}
 
+	if (this->type.length() > 0) {
+		std::cout << "Type: " << this->type << std::endl;
+	}
+
 	if (input_names.size() > 0) {
 		std::cout << "Input names: ";
 		this->table.print_input_names();
@@ -423,6 +689,12 @@ void BenchmarkFileReader<T>::read_header() {
 		this->header_size++;
 	}
 
+	this->read_type();
+
+	if (this->type.length() > 0) {
+		this->header_size++;
+	}
+
 	std::vector<std::string> &input_names = this->table.get_input_names();
 	std::vector<std::string> &output_names = this->table.get_output_names();
 
@@ -457,29 +729,56 @@ void BenchmarkFileReader<T>::read_tt_file(std::string file_path) {
 		ifs.clear();
 		ifs.seekg(0, std::ios::beg);
 
-		int rows;
 		std::string line;
-		std::string s;
-		char *term;
+
+		if (this->num_inputs < 0 || this->num_outputs < 0) {
+			throw std::runtime_error("Invalid TT header!");
+		}
+
+		if (this->num_inputs > 63) {
+			throw std::runtime_error("Number of inputs exceeds the table size!");
+		}
 
 		for (int i = 0; i < this->header_size; i++) {
 			std::getline(ifs, line);
 		}
 
 		int offset = this->num_inputs + 1;
+		int width = offset + this->num_outputs;
+		int column;
 
-		// Vectors for the data of each row
-		std::vector<T> row_inputs;
-		std::vector<T> row_outputs;
+		// Bitmasks of the decoded row
+		uint64_t input_value = 0;
+		uint64_t input_care = 0;
+		std::vector<uint64_t> output_value(
+				LineDecoder::num_words(this->num_outputs));
+		std::vector<uint64_t> output_care(output_value.size());
 
 		// Clear the table from potential previous data, reset the compressed status
 		table.reset();
 
-		rows = std::pow(2, this->num_inputs);
+		uint64_t rows = uint64_t(1) << this->num_inputs;
 		this->table.set_compressed(false);
 
+		// Dense bit vectors of the output columns
+		std::vector<WordVector> words(this->num_outputs,
+				WordVector(OutputColumn::num_words(rows), 0,
+						this->table.get_allocation_policy()));
+
+		if (this->num_threads != 1) {
+			this->read_tt_body_parallel(file_path, ifs.tellg(), rows, words);
+			this->table.set_output_columns(words, rows);
+
+			// Expand the row-major vectors from the packed columns on demand
+			if (this->keep_rows) {
+				this->table.generate_inputs(this->num_inputs);
+				this->table.expand_outputs();
+			}
+			return;
+		}
+
 		// Iterate over the number of rows
-		for (int i = 0; i < rows; i++) {
+		for (uint64_t i = 0; i < rows; i++) {
 
 			std::getline(ifs, line);
 
@@ -488,29 +787,219 @@ void BenchmarkFileReader<T>::read_tt_file(std::string file_path) {
 				throw std::runtime_error("Error while reading TT file!");
 			}
 
-			for (int j = 0; j < this->num_inputs; j++) {
-				s = line.at(j);
-				row_inputs.push_back(std::stoi(s));
+			if ((int) line.size() < width) {
+				this->throw_parse_error("TT", i, line.size());
+			}
+
+			// Inputs and outputs of a TT file must be fully specified
+			column = LineDecoder::decode(line.data(), this->num_inputs,
+					&input_value, &input_care);
+
+			if (column < 0) {
+				column = LineDecoder::find_clear(&input_care, this->num_inputs);
+			}
+
+			// The inputs have to match the row index
+			if (column < 0
+					&& LineDecoder::to_row_order(input_value,
+							this->num_inputs) != i) {
+				column = 0;
+			}
+
+			if (column >= 0) {
+				this->throw_parse_error("TT", i, column);
+			}
+
+			column = LineDecoder::decode(line.data() + offset,
+					this->num_outputs, output_value.data(), output_care.data());
+
+			if (column < 0) {
+				column = LineDecoder::find_clear(output_care.data(),
+						this->num_outputs);
+			}
+
+			if (column >= 0) {
+				this->throw_parse_error("TT", i, offset + column);
 			}
 
 			for (int j = 0; j < this->num_outputs; j++) {
-				s = line.at(offset + j);
-				row_outputs.push_back(std::stoi(s));
+				if ((output_value[j >> 6] >> (j & 63)) & 1) {
+					words[j][i >> 6] |= uint64_t(1) << (i & 63);
+				}
 			}
+		}
 
-			// Store the chunks in the 2D vectors of the truth table
-			this->table.append_inputs(row_inputs);
-			this->table.append_outputs(row_outputs);
+		this->check_body_end(ifs, "TT", rows);
 
-			row_inputs.clear();
-			row_outputs.clear();
+		this->table.set_output_columns(words, rows);
 
+		// Expand the row-major vectors from the packed columns on demand
+		if (this->keep_rows) {
+			this->table.generate_inputs(this->num_inputs);
+			this->table.expand_outputs();
 		}
 	} else {
 		throw std::runtime_error("Error opening benchmark file!");
 	}
 }
 
+/**
+ * @brief Parses the body of a TT file with several threads.
+ *
+ * @details All rows of a TT file have the same width. Therefore, the byte range of
+ * every row is known from the width of the first row, and the body is split into
+ * ranges of whole 64-row words. Each thread reads its range with its own file stream
+ * and writes the decoded outputs directly into the words of its rows. The rows have
+ * to be in ascending order, which is validated by comparing the inputs of each row
+ * with its index. The error with the lowest row is reported after all threads
+ * have finished.
+ *
+ * @param file_path Path of the TT file
+ * @param body_offset Byte offset of the first row
+ * @param rows Number of rows of the table
+ * @param words Dense bit vectors of the output columns
+ */
+template<class T>
+void BenchmarkFileReader<T>::read_tt_body_parallel(std::string file_path,
+		std::streamoff body_offset, uint64_t rows,
+		std::vector<WordVector> &words) {
+
+	std::string first;
+	std::getline(ifs, first);
+
+	if (ifs.fail()) {
+		throw std::runtime_error("Error while reading TT file!");
+	}
+
+	// Row width including the line break
+	uint64_t stride = first.size() + 1;
+	int offset = this->num_inputs + 1;
+
+	if ((int) first.size() < offset + this->num_outputs) {
+		this->throw_parse_error("TT", 0, first.size());
+	}
+
+	if (std::filesystem::file_size(file_path) < body_offset + rows * stride) {
+		throw std::runtime_error("Error while reading TT file: Body is truncated!");
+	}
+
+	uint64_t num_words = OutputColumn::num_words(rows);
+	int threads = parallel_workers(num_words, this->num_threads);
+
+	// Lowest row with an error and its column
+	std::atomic<uint64_t> error_row(rows);
+	std::atomic<int> error_column(0);
+	std::mutex error_mutex;
+
+	auto report = [&](uint64_t p_row, int p_column) {
+		std::lock_guard<std::mutex> lock(error_mutex);
+		if (p_row < error_row.load()) {
+			error_row = p_row;
+			error_column = p_column;
+		}
+	};
+
+	auto work = [&](uint64_t p_begin, uint64_t p_end) {
+
+		std::ifstream stream(file_path, std::ifstream::in | std::ifstream::binary);
+
+		// Rows are read in blocks to bound the buffer size
+		const uint64_t block_rows = 4096;
+		std::vector<char> buffer(block_rows * stride);
+
+		uint64_t input_value;
+		uint64_t input_care;
+		std::vector<uint64_t> output_value(
+				LineDecoder::num_words(this->num_outputs));
+		std::vector<uint64_t> output_care(output_value.size());
+
+		stream.seekg(body_offset + p_begin * stride, std::ios::beg);
+
+		for (uint64_t b = p_begin; b < p_end; b += block_rows) {
+			uint64_t n = std::min(block_rows, p_end - b);
+
+			// Stop early when a preceding row is already known to be invalid
+			if (error_row.load(std::memory_order_relaxed) < b) {
+				return;
+			}
+
+			stream.read(buffer.data(), n * stride);
+
+			if (!stream) {
+				report(b, 0);
+				return;
+			}
+
+			for (uint64_t r = 0; r < n; r++) {
+				const char *line = buffer.data() + r * stride;
+				uint64_t row = b + r;
+				int column;
+
+				if (line[stride - 1] != '\n') {
+					report(row, stride - 1);
+					return;
+				}
+
+				column = LineDecoder::decode(line, this->num_inputs,
+						&input_value, &input_care);
+
+				if (column < 0) {
+					column = LineDecoder::find_clear(&input_care,
+							this->num_inputs);
+				}
+
+				// The inputs have to match the row index
+				if (column < 0
+						&& LineDecoder::to_row_order(input_value,
+								this->num_inputs) != row) {
+					column = 0;
+				}
+
+				if (column >= 0) {
+					report(row, column);
+					return;
+				}
+
+				column = LineDecoder::decode(line + offset, this->num_outputs,
+						output_value.data(), output_care.data());
+
+				if (column < 0) {
+					column = LineDecoder::find_clear(output_care.data(),
+							this->num_outputs);
+				}
+
+				if (column >= 0) {
+					report(row, offset + column);
+					return;
+				}
+
+				for (int j = 0; j < this->num_outputs; j++) {
+					if ((output_value[j >> 6] >> (j & 63)) & 1) {
+						words[j][row >> 6] |= uint64_t(1) << (row & 63);
+					}
+				}
+			}
+		}
+	};
+
+	// Split the rows into one range of whole words per thread
+	parallel_for(threads, threads, [&](uint64_t p_range, int) {
+		uint64_t begin = num_words * p_range / threads * 64;
+		uint64_t end = std::min(num_words * (p_range + 1) / threads * 64, rows);
+
+		work(begin, end);
+	});
+
+	if (error_row.load() < rows) {
+		this->throw_parse_error("TT", error_row.load(), error_column.load());
+	}
+
+	ifs.clear();
+	ifs.seekg(body_offset + rows * stride, std::ios::beg);
+
+	this->check_body_end(ifs, "TT", rows);
+}
+
 /**
  *
  */
@@ -538,7 +1027,23 @@ std::vector<std::vector<char>>* BenchmarkFileReader<T>::generate_input_table() {
 }
 
 /**
+ * @brief Reads a PLA file and expands its cubes into the output columns.
+ *
+ * @details Each character of the output part assigns the cube to a set of the
+ * respective output: '1' to the ON-set, '0' to the OFF-set, '-' to the don't care
+ * set and '~' to none. Which sets are given is defined by the .type keyword as in
+ * espresso, where fd is the default:
  *
+ * 		f   : ON-set, all other rows are 0.
+ * 		fd  : ON-set and don't care set, all other rows are 0.
+ * 		fr  : ON-set and OFF-set, all other rows are don't care.
+ * 		fdr : ON-set, don't care set and OFF-set, all other rows are don't care.
+ *
+ * Rows which are in the don't care set are don't care, even if they are also covered
+ * by the ON-set. The care masks are only stored in the table if any output has don't
+ * care rows. Every cube is expanded by enumerating its subspace.
+ *
+ * @param file_path Path of the PLA file
  */
 template<class T>
 void BenchmarkFileReader<T>::read_pla_file(std::string file_path) {
@@ -555,74 +1060,190 @@ void BenchmarkFileReader<T>::read_pla_file(std::string file_path) {
 		ifs.seekg(0, std::ios::beg);
 
 		std::string line;
-		std::vector<char> minterm(this->num_inputs);
 		int output_index;
+		int column;
+
+		std::vector<Minterm> minterms;
 
-		std::vector<Minterm*> minterms;
+		// Bitmasks of the decoded input part
+		uint64_t input_value;
+		uint64_t input_care;
+
+		if (this->num_inputs > 63) {
+			throw std::runtime_error("Number of inputs exceeds the table size!");
+		}
 
 		for (int i = 0; i < this->header_size; i++) {
 			std::getline(ifs, line);
 		}
 
+		minterms.reserve(std::max(this->num_product_terms, 0));
+
 		for (int i = 0; i < this->num_product_terms; i++) {
 
 			std::getline(ifs, line);
 
 			// Check if any error state flags have been set
 			if (ifs.fail() || ifs.eof() || ifs.bad()) {
-				throw std::runtime_error("Error while reading TT file!");
+				throw std::runtime_error("Error while reading PLA file!");
+			}
+
+			if ((int) line.size() < this->num_inputs + 1 + this->num_outputs) {
+				this->throw_parse_error("PLA", i, line.size());
 			}
 
-			for (int j = 0; j < this->num_inputs; j++) {
-				minterm.at(j) = line.at(j);
+			column = LineDecoder::decode(line.data(), this->num_inputs,
+					&input_value, &input_care);
+
+			if (column >= 0) {
+				this->throw_parse_error("PLA", i, column);
 			}
 
+			std::string outputs = line.substr(this->num_inputs + 1,
+					this->num_outputs);
+
+			// The last output with a '1' is kept as output index of the term
+			output_index = -1;
+
 			for (int j = 0; j < this->num_outputs; j++) {
-				char c = line.at(this->num_inputs + 1 + j);
+				char c = outputs[j];
+
 				if (c == '1') {
 					output_index = j;
+				} else if (c != '0' && c != '-' && c != '~') {
+					this->throw_parse_error("PLA", i, this->num_inputs + 1 + j);
 				}
 			}
 
-			Minterm *term = new Minterm(this->num_inputs, output_index);
-
-			term->set_term(&minterm);
-			minterms.push_back(term);
+			minterms.emplace_back(output_index);
+			minterms.back().set_masks(
+					LineDecoder::to_row_order(input_value, this->num_inputs),
+					LineDecoder::to_row_order(input_care, this->num_inputs));
+			minterms.back().set_outputs(outputs);
 		}
 
-		std::vector<std::vector<char>> *input_table = generate_input_table();
-		int num_rows = std::pow(2.0, this->num_inputs);
+		// Clear the table from potential previous data
+		this->table.reset();
+		this->cover = Cover(this->keep_cover ? this->num_inputs : 0,
+				this->keep_cover ? this->num_outputs : 0);
 
-		this->table.generate_inputs(this->num_inputs);
-		this->table.init_outputs(this->num_outputs, num_rows);
+		uint64_t num_rows = uint64_t(1) << this->num_inputs;
+		uint64_t num_words = OutputColumn::num_words(num_rows);
 
-		/*
-		for (int i = 0; i < num_rows; i++) {
-			std::vector<char> input_vec = input_table->at(i);
+		bool has_dc_set = (this->type == "" || this->type == "fd"
+				|| this->type == "fdr");
+		bool has_off_set = (this->type == "fr" || this->type == "fdr");
 
-			for (int j = 0; j < this->num_product_terms; j++) {
-				bool match = minterms[j]->match(&input_vec);
+		// Dense bit vectors of the ON-sets, don't care sets and OFF-sets
+		std::vector<WordVector> words(this->num_outputs,
+				WordVector(num_words, 0, this->table.get_allocation_policy()));
+		std::vector<WordVector> dc_words(this->num_outputs);
+		std::vector<WordVector> off_words(this->num_outputs);
 
-				if (match) {
-					int output_index = minterms[j]->get_output_index();
-					table.set_output_at(i, output_index, 1);
+		for (const Minterm &term : minterms) {
+
+			Cube cube;
+			cube.value = term.get_value_mask();
+			cube.care = term.get_care_mask();
+
+			if (this->keep_cover && term.get_output_index() >= 0) {
+				cube.outputs.assign(LineDecoder::num_words(this->num_outputs), 0);
+
+				for (int j = 0; j < this->num_outputs; j++) {
+					if (term.get_outputs()[j] == '1') {
+						cube.outputs[j >> 6] |= uint64_t(1) << (j & 63);
+					}
 				}
+
+				this->cover.add_cube(cube);
 			}
-		}*/
 
-		for (int j = 0; j < this->num_product_terms; j++) {
-			for (int i = 0; i < num_rows; i++) {
-				std::vector<char> input_vec = input_table->at(i);
-				bool match = minterms[j]->match(&input_vec);
+			for (int j = 0; j < this->num_outputs; j++) {
+				WordVector *target = nullptr;
+
+				switch (term.get_outputs()[j]) {
+				case '1':
+					target = &words[j];
+					break;
+				case '-':
+					target = has_dc_set ? &dc_words[j] : nullptr;
+					break;
+				case '0':
+					target = has_off_set ? &off_words[j] : nullptr;
+					break;
+				}
 
-				if (match) {
-					int output_index = minterms[j]->get_output_index();
-					table.set_output_at(i, output_index, 1);
+				if (target == nullptr) {
+					continue;
 				}
+
+				// The don't care and OFF-sets are only allocated when they are used
+				if (target->empty()) {
+					target->assign(num_words, 0);
+				}
+
+				Cover::for_each_row(cube, this->num_inputs, [target](uint64_t row) {
+					(*target)[row >> 6] |= uint64_t(1) << (row & 63);
+				});
 			}
 		}
 
-		delete input_table;
+		// Without an OFF-set and don't care rows, all outputs are completely specified
+		bool needs_care = has_off_set;
+
+		for (int j = 0; j < this->num_outputs && !needs_care; j++) {
+			needs_care = !dc_words[j].empty();
+		}
+
+		// Care mask of each output, all ones for completely specified outputs
+		std::vector<WordVector> care_words;
+		bool has_dont_cares = false;
+
+		for (int j = 0; j < this->num_outputs && needs_care; j++) {
+			WordVector care(num_words, ~uint64_t(0),
+					this->table.get_allocation_policy());
+
+			for (uint64_t w = 0; w < num_words; w++) {
+				if (has_off_set) {
+					care[w] = words[j][w]
+							| (off_words[j].empty() ? 0 : off_words[j][w]);
+				}
+
+				if (!dc_words[j].empty()) {
+					care[w] &= ~dc_words[j][w];
+				}
+
+				words[j][w] &= care[w];
+			}
+
+			if (num_rows < 64) {
+				care[0] &= (uint64_t(1) << num_rows) - 1;
+			}
+
+			for (uint64_t w = 0; w < num_words && !has_dont_cares; w++) {
+				uint64_t all = (num_rows < 64) ?
+						(uint64_t(1) << num_rows) - 1 : ~uint64_t(0);
+				has_dont_cares = (care[w] != all);
+			}
+
+			care_words.push_back(std::move(care));
+			WordVector().swap(dc_words[j]);
+			WordVector().swap(off_words[j]);
+		}
+
+		this->table.set_output_columns(words, num_rows);
+
+		if (has_dont_cares) {
+			this->table.set_care_columns(care_words, num_rows);
+		}
+
+		// Expand the row-major vectors from the packed columns on demand
+		if (this->keep_rows) {
+			this->table.generate_inputs(this->num_inputs);
+			this->table.expand_outputs();
+		} else {
+			this->table.release_rows();
+		}
 	}
 
 }
@@ -654,8 +1275,8 @@ if (ifs.is_open()) {
 
 	std::string str;
 
-	T input;
-	T output;
+	uint64_t input;
+	uint64_t output;
 
 	// Vectors for the data of each row
 	std::vector<T> row_inputs;
@@ -664,8 +1285,26 @@ if (ifs.is_open()) {
 	// Clear the table from potential previous data, reset the compressed status
 	table.reset();
 
-	rows = this->num_chunks;
-	this->table.set_compressed(true);
+	// The .p line of a PLU file gives the number of chunks
+	rows = (this->num_chunks >= 0) ? this->num_chunks : this->num_product_terms;
+	this->table.set_compressed(this->keep_rows);
+
+	if (this->num_inputs < 0 || this->num_inputs > 63 || rows < 0) {
+		throw std::runtime_error("Invalid PLU header!");
+	}
+
+	// Bit b of chunk i is the value in row CHUNK_SIZE * i + b
+	const int CHUNK_SIZE = 32;
+
+	uint64_t num_rows = uint64_t(1) << this->num_inputs;
+	std::vector<WordVector> words(this->num_outputs,
+			WordVector(OutputColumn::num_words(num_rows), 0,
+					this->table.get_allocation_policy()));
+
+	// Skip the header
+	for (int i = 0; i < this->header_size; i++) {
+		std::getline(ifs, str);
+	}
 
 	// Iterate over the number of chunks
 	for (int i = 0; i < rows; i++) {
@@ -679,7 +1318,7 @@ if (ifs.is_open()) {
 		// them in the temporary vector
 		for (int j = 0; j < this->num_inputs; j++) {
 			ifs >> input;
-			row_inputs.push_back(input);
+			row_inputs.push_back((T) input);
 		}
 
 		// Inputs and outputs are seperated with whitespaces
@@ -691,18 +1330,36 @@ if (ifs.is_open()) {
 		// Read and store the outputs of the current row
 		for (int j = 0; j < this->num_outputs; j++) {
 			ifs >> output;
-			row_outputs.push_back(output);
+			row_outputs.push_back((T) output);
+
+			uint64_t row = uint64_t(i) * CHUNK_SIZE;
+
+			if (row < num_rows) {
+				if (num_rows - row < CHUNK_SIZE) {
+					output &= (uint64_t(1) << (num_rows - row)) - 1;
+				}
+
+				words[j][row >> 6] |= (output & 0xFFFFFFFFULL) << (row & 63);
+			}
 		}
 
 		// Store the chunks in the 2D vectors of the truth table
-		this->table.append_inputs(row_inputs);
-		this->table.append_outputs(row_outputs);
+		if (this->keep_rows) {
+			this->table.append_inputs(row_inputs);
+			this->table.append_outputs(row_outputs);
+		}
 
 		row_inputs.clear();
 		row_outputs.clear();
 
 	}
 
+	if (ifs.fail()) {
+		throw std::runtime_error("Error while reading PLU file!");
+	}
+
+	this->table.set_output_columns(words, num_rows);
+
 } else {
 	throw std::runtime_error("Error opening benchmark file!");
 }
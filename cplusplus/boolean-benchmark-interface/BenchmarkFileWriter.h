@@ -0,0 +1,470 @@
+#ifndef BENCHMARKFILEWRITER_H_
+#define BENCHMARKFILEWRITER_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "TruthTable.h"
+#include "Cover.h"
+
+/*
+ * @brief Writes truth tables and covers as PLU, PLA or TT benchmark files.
+ *
+ * @details The tables are written from their packed output columns, so tables
+ * which have been generated in memory or read with released rows can be written
+ * without expanding them. The rows are formatted word by word into a buffer which
+ * is flushed in large blocks.
+ *
+ * PLA files are written with one output per line, as expected by the readers of
+ * this repository. In PLU files, the table is divided into chunks of 32 rows and
+ * bit b of a chunk value is the value in row b of the chunk.
+ *
+ * @tparam T Generic type of the truth table.
+ */
+template<class T>
+class BenchmarkFileWriter {
+private:
+	static const int CHUNK_SIZE = 32;
+	static const size_t BUFFER_SIZE = 1 << 20;
+
+	std::ofstream ofs;
+	std::string buffer;
+
+	void open_file(std::string file_path);
+	void close_file();
+	void flush(bool force = false);
+
+	void write_header(const std::string &p_model_name, int p_num_inputs,
+			int p_num_outputs, int64_t p_num_product_terms,
+			const std::vector<std::string> &p_input_names,
+			const std::vector<std::string> &p_output_names,
+			const std::string &p_type = "");
+
+	static const std::vector<OutputColumn>& validate_table(
+			const TruthTable<T> &p_table);
+
+	template<class F>
+	static void for_each_row(const std::vector<OutputColumn> &p_columns,
+			const std::vector<OutputColumn> &p_care_columns, F p_func);
+
+public:
+	// Constants for the status of the file format
+	static const int PLU = 0;
+	static const int PLA = 1;
+	static const int TT = 2;
+
+	BenchmarkFileWriter() = default;
+	virtual ~BenchmarkFileWriter() = default;
+
+	static int file_format(std::string file_path);
+
+	void write_file(std::string file_path, const TruthTable<T> &p_table);
+
+	void write_tt_file(std::string file_path, const TruthTable<T> &p_table);
+	void write_pla_file(std::string file_path, const TruthTable<T> &p_table);
+	void write_pla_file(std::string file_path, const Cover &p_cover,
+			std::string p_model_name = "",
+			const std::vector<std::string> &p_input_names = {},
+			const std::vector<std::string> &p_output_names = {});
+	void write_plu_file(std::string file_path, const TruthTable<T> &p_table);
+};
+
+/**
+ * @brief Returns the file format which belongs to the extension of the path.
+ */
+template<class T>
+int BenchmarkFileWriter<T>::file_format(std::string file_path) {
+
+	std::string extension = std::filesystem::path(file_path).extension();
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	if (extension == ".plu") {
+		return PLU;
+	} else if (extension == ".pla") {
+		return PLA;
+	} else if (extension == ".tt") {
+		return TT;
+	}
+
+	throw std::runtime_error("Unknown benchmark file extension!");
+}
+
+template<class T>
+void BenchmarkFileWriter<T>::open_file(std::string file_path) {
+
+	this->ofs.open(file_path, std::ofstream::out | std::ofstream::binary);
+
+	if (!this->ofs.is_open()) {
+		throw std::runtime_error("Error opening benchmark file for writing!");
+	}
+
+	this->buffer.clear();
+	this->buffer.reserve(BUFFER_SIZE + 4096);
+}
+
+template<class T>
+void BenchmarkFileWriter<T>::close_file() {
+
+	this->flush(true);
+	this->ofs.close();
+
+	if (this->ofs.fail()) {
+		throw std::runtime_error("Error while writing benchmark file!");
+	}
+}
+
+/**
+ * @brief Writes the buffer to the file once it exceeds the block size.
+ */
+template<class T>
+void BenchmarkFileWriter<T>::flush(bool force) {
+
+	if (force || this->buffer.size() >= BUFFER_SIZE) {
+		this->ofs.write(this->buffer.data(), this->buffer.size());
+		this->buffer.clear();
+	}
+}
+
+template<class T>
+void BenchmarkFileWriter<T>::write_header(const std::string &p_model_name,
+		int p_num_inputs, int p_num_outputs, int64_t p_num_product_terms,
+		const std::vector<std::string> &p_input_names,
+		const std::vector<std::string> &p_output_names,
+		const std::string &p_type) {
+
+	if (p_model_name.length() > 0) {
+		this->buffer += ".model " + p_model_name + "\n";
+	}
+
+	this->buffer += ".i " + std::to_string(p_num_inputs) + "\n";
+	this->buffer += ".o " + std::to_string(p_num_outputs) + "\n";
+
+	if (p_num_product_terms >= 0) {
+		this->buffer += ".p " + std::to_string(p_num_product_terms) + "\n";
+	}
+
+	if (p_type.length() > 0) {
+		this->buffer += ".type " + p_type + "\n";
+	}
+
+	if (p_input_names.size() > 0) {
+		this->buffer += ".ilb";
+		for (const std::string &name : p_input_names) {
+			this->buffer += " " + name;
+		}
+		this->buffer += "\n";
+	}
+
+	if (p_output_names.size() > 0) {
+		this->buffer += ".ob";
+		for (const std::string &name : p_output_names) {
+			this->buffer += " " + name;
+		}
+		this->buffer += "\n";
+	}
+}
+
+/**
+ * @brief Returns the output columns of a table whose number of rows is a power of two.
+ */
+template<class T>
+const std::vector<OutputColumn>& BenchmarkFileWriter<T>::validate_table(
+		const TruthTable<T> &p_table) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	uint64_t num_rows = columns.at(0).rows();
+
+	if ((num_rows & (num_rows - 1)) != 0 || num_rows > (uint64_t(1) << 63)) {
+		throw std::runtime_error("Number of rows is not a power of two!");
+	}
+
+	return columns;
+}
+
+/**
+ * @brief Calls the given function for every row with the output words of its block.
+ *
+ * @tparam F Callable with the signature void(uint64_t row, const uint64_t *words),
+ * where bit (row % 64) of words[j] is the value of output j and bit (row % 64) of
+ * words[m + j] is its care bit, m being the number of outputs
+ *
+ * @param p_care_columns Care masks of the outputs, empty if all rows are specified
+ */
+template<class T>
+template<class F>
+void BenchmarkFileWriter<T>::for_each_row(const std::vector<OutputColumn> &p_columns,
+		const std::vector<OutputColumn> &p_care_columns, F p_func) {
+
+	uint64_t num_rows = p_columns.at(0).rows();
+	size_t m = p_columns.size();
+	std::vector<uint64_t> words(2 * m, ~uint64_t(0));
+
+	for (uint64_t w = 0; w < OutputColumn::num_words(num_rows); w++) {
+		for (size_t j = 0; j < m; j++) {
+			p_columns[j].copy_words(w, 1, &words[j]);
+		}
+
+		for (size_t j = 0; j < p_care_columns.size(); j++) {
+			p_care_columns[j].copy_words(w, 1, &words[m + j]);
+		}
+
+		uint64_t end = std::min<uint64_t>(num_rows, (w + 1) << 6);
+
+		for (uint64_t r = w << 6; r < end; r++) {
+			p_func(r, words.data());
+		}
+	}
+}
+
+/**
+ * @brief Writes a table in the format given by the extension of the path.
+ */
+template<class T>
+void BenchmarkFileWriter<T>::write_file(std::string file_path,
+		const TruthTable<T> &p_table) {
+
+	switch (file_format(file_path)) {
+	case PLU:
+		this->write_plu_file(file_path, p_table);
+		break;
+	case PLA:
+		this->write_pla_file(file_path, p_table);
+		break;
+	default:
+		this->write_tt_file(file_path, p_table);
+	}
+}
+
+/**
+ * @brief Writes the complete truth table with one line per row.
+ *
+ * @details TT files can't represent don't cares, tables with care masks have to
+ * be written as PLA file.
+ */
+template<class T>
+void BenchmarkFileWriter<T>::write_tt_file(std::string file_path,
+		const TruthTable<T> &p_table) {
+
+	const std::vector<OutputColumn> &columns = validate_table(p_table);
+
+	if (p_table.has_care_columns()) {
+		throw std::runtime_error("TT files can't represent don't care rows!");
+	}
+
+	int n = __builtin_ctzll(columns.at(0).rows());
+	int m = columns.size();
+
+	this->open_file(file_path);
+	this->write_header(p_table.get_model_name(), n, m, -1,
+			p_table.get_input_names(), p_table.get_output_names());
+
+	std::string line(n + m + 2, ' ');
+	line[n + m + 1] = '\n';
+
+	for_each_row(columns, {}, [&](uint64_t p_row, const uint64_t *p_words) {
+		for (int i = 0; i < n; i++) {
+			line[i] = '0' + ((p_row >> (n - 1 - i)) & 1);
+		}
+
+		for (int j = 0; j < m; j++) {
+			line[n + 1 + j] = '0' + ((p_words[j] >> (p_row & 63)) & 1);
+		}
+
+		this->buffer += line;
+		this->flush();
+	});
+
+	this->buffer += ".end\n";
+	this->close_file();
+}
+
+/**
+ * @brief Writes the ON-sets of a table as minterms, one line per row and output.
+ *
+ * @details Tables with care masks are written with type fd, where the don't care
+ * rows of an output are minterms with a '-' for the output.
+ */
+template<class T>
+void BenchmarkFileWriter<T>::write_pla_file(std::string file_path,
+		const TruthTable<T> &p_table) {
+
+	const std::vector<OutputColumn> &columns = validate_table(p_table);
+	const std::vector<OutputColumn> &care_columns = p_table.get_care_columns();
+
+	uint64_t num_rows = columns.at(0).rows();
+
+	int n = __builtin_ctzll(num_rows);
+	int m = columns.size();
+
+	uint64_t num_product_terms = 0;
+
+	for (const OutputColumn &column : columns) {
+		num_product_terms += column.count_ones();
+	}
+
+	for (const OutputColumn &column : care_columns) {
+		num_product_terms += num_rows - column.count_ones();
+	}
+
+	this->open_file(file_path);
+	this->write_header(p_table.get_model_name(), n, m, num_product_terms,
+			p_table.get_input_names(), p_table.get_output_names(),
+			care_columns.empty() ? "" : "fd");
+
+	std::string line(n + m + 2, '0');
+	line[n] = ' ';
+	line[n + m + 1] = '\n';
+
+	for_each_row(columns, care_columns,
+			[&](uint64_t p_row, const uint64_t *p_words) {
+		bool input_set = false;
+
+		for (int j = 0; j < m; j++) {
+			bool value = (p_words[j] >> (p_row & 63)) & 1;
+			bool care = (p_words[m + j] >> (p_row & 63)) & 1;
+
+			if (care && !value) {
+				continue;
+			}
+
+			if (!input_set) {
+				for (int i = 0; i < n; i++) {
+					line[i] = '0' + ((p_row >> (n - 1 - i)) & 1);
+				}
+				input_set = true;
+			}
+
+			line[n + 1 + j] = care ? '1' : '-';
+			this->buffer += line;
+			line[n + 1 + j] = '0';
+		}
+
+		this->flush();
+	});
+
+	this->buffer += ".e\n";
+	this->close_file();
+}
+
+/**
+ * @brief Writes a cover, one line per cube and output.
+ */
+template<class T>
+void BenchmarkFileWriter<T>::write_pla_file(std::string file_path,
+		const Cover &p_cover, std::string p_model_name,
+		const std::vector<std::string> &p_input_names,
+		const std::vector<std::string> &p_output_names) {
+
+	int n = p_cover.get_num_inputs();
+	int m = p_cover.get_num_outputs();
+
+	uint64_t num_product_terms = 0;
+
+	for (const Cube &cube : p_cover.get_cubes()) {
+		for (uint64_t word : cube.outputs) {
+			num_product_terms += __builtin_popcountll(word);
+		}
+	}
+
+	this->open_file(file_path);
+	this->write_header(p_model_name, n, m, num_product_terms, p_input_names,
+			p_output_names);
+
+	std::string line(n + m + 2, '0');
+	line[n] = ' ';
+	line[n + m + 1] = '\n';
+
+	for (const Cube &cube : p_cover.get_cubes()) {
+		std::string inputs = p_cover.input_string(cube);
+		std::copy(inputs.begin(), inputs.end(), line.begin());
+
+		for (int j = 0; j < m; j++) {
+			if ((cube.outputs[j >> 6] >> (j & 63)) & 1) {
+				line[n + 1 + j] = '1';
+				this->buffer += line;
+				line[n + 1 + j] = '0';
+			}
+		}
+
+		this->flush();
+	}
+
+	this->buffer += ".e\n";
+	this->close_file();
+}
+
+/**
+ * @brief Writes the table compressed into chunks of 32 rows.
+ *
+ * @details Each line holds the chunk values of all inputs followed by those of all
+ * outputs. Tables with less than 32 rows consist of a single chunk.
+ */
+template<class T>
+void BenchmarkFileWriter<T>::write_plu_file(std::string file_path,
+		const TruthTable<T> &p_table) {
+
+	const std::vector<OutputColumn> &columns = validate_table(p_table);
+
+	if (p_table.has_care_columns()) {
+		throw std::runtime_error("PLU files can't represent don't care rows!");
+	}
+
+	uint64_t num_rows = columns.at(0).rows();
+	uint64_t num_chunks = (num_rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+	int n = __builtin_ctzll(num_rows);
+	int m = columns.size();
+
+	this->open_file(file_path);
+
+	this->buffer += ".i " + std::to_string(n) + "\n";
+	this->buffer += ".o " + std::to_string(m) + "\n";
+	this->buffer += ".p " + std::to_string(num_chunks) + "\n";
+
+	std::vector<uint64_t> words(m);
+
+	for (uint64_t c = 0; c < num_chunks; c++) {
+		uint64_t first = c * CHUNK_SIZE;
+		int shift = (first & 63);
+		int size = std::min<uint64_t>(CHUNK_SIZE, num_rows);
+		uint64_t mask = (uint64_t(1) << size) - 1;
+
+		if (shift == 0) {
+			for (int j = 0; j < m; j++) {
+				columns[j].copy_words(first >> 6, 1, &words[j]);
+			}
+		}
+
+		for (int i = 0; i < n; i++) {
+			uint64_t value = 0;
+
+			for (int b = 0; b < size; b++) {
+				value |= (((first + b) >> (n - 1 - i)) & 1) << b;
+			}
+
+			this->buffer += std::to_string(value) + " ";
+		}
+
+		for (int j = 0; j < m; j++) {
+			this->buffer += " " + std::to_string((words[j] >> shift) & mask);
+		}
+
+		this->buffer += "\n";
+		this->flush();
+	}
+
+	this->buffer += ".e\n";
+	this->close_file();
+}
+
+#endif /* BENCHMARKFILEWRITER_H_ */
@@ -0,0 +1,422 @@
+#ifndef BENCHMARKGENERATOR_H_
+#define BENCHMARKGENERATOR_H_
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "OutputColumn.h"
+#include "TruthTable.h"
+#include "InputPatternCache.h"
+#include "Cover.h"
+
+/*
+ * @brief Builds synthetic benchmark functions of arbitrary size in memory.
+ *
+ * @details The tables are constructed word-parallel: every input is represented by
+ * the 64 bit word of its values in 64 consecutive rows, and the outputs are computed
+ * with bitwise operations on these words, i.e. 64 rows at once. The generated tables
+ * only hold the packed output columns. Their input columns are taken from the
+ * InputPatternCache, the row-major vectors can be created with generate_inputs()
+ * and expand_outputs() of the table when they are needed.
+ *
+ * As in the benchmark files, input 0 is the most significant bit of the row index.
+ * Operands of arithmetic functions are given most significant bit first, and the
+ * outputs are ordered most significant bit first as well.
+ *
+ * The inputs are named x0, x1, ... and the outputs y0, y1, ...
+ */
+class BenchmarkGenerator {
+private:
+	template<class F>
+	static std::vector<WordVector> build(int p_num_inputs, int p_num_outputs,
+			F p_func);
+
+	template<class T>
+	static TruthTable<T> make_table(std::string p_model_name, int p_num_inputs,
+			const std::vector<WordVector> &p_words);
+
+	static void validate_inputs(int p_num_inputs);
+
+public:
+	template<class T>
+	static TruthTable<T> parity(int p_num_inputs);
+	template<class T>
+	static TruthTable<T> adder(int p_bits);
+	template<class T>
+	static TruthTable<T> multiplier(int p_bits);
+	template<class T>
+	static TruthTable<T> comparator(int p_bits);
+	template<class T>
+	static TruthTable<T> multiplexer(int p_select_bits);
+	template<class T>
+	static TruthTable<T> random(int p_num_inputs, int p_num_outputs,
+			uint64_t p_seed);
+
+	static Cover parity_cover(int p_num_inputs);
+	static Cover multiplexer_cover(int p_select_bits);
+	template<class T>
+	static Cover minterm_cover(const TruthTable<T> &p_table);
+};
+
+/**
+ * @brief Generated tables are limited to 2^40 rows, i.e. 128 GiB per output column.
+ */
+inline void BenchmarkGenerator::validate_inputs(int p_num_inputs) {
+	if (p_num_inputs < 0 || p_num_inputs > InputPatternCache::MAX_INPUTS) {
+		throw std::runtime_error("Number of inputs is out of range!");
+	}
+}
+
+/**
+ * @brief Computes the dense output words of a function word by word.
+ *
+ * @tparam F Callable with the signature void(const uint64_t *x, uint64_t *y), which
+ * computes the output words y from the input words x of the same 64 rows
+ *
+ * @return Dense bit vector for each output
+ */
+template<class F>
+std::vector<WordVector> BenchmarkGenerator::build(int p_num_inputs,
+		int p_num_outputs, F p_func) {
+
+	validate_inputs(p_num_inputs);
+
+	uint64_t num_rows = uint64_t(1) << p_num_inputs;
+	uint64_t num_words = OutputColumn::num_words(num_rows);
+
+	// Tables with less than 64 rows only use the low bits of their word
+	uint64_t tail = (num_rows < 64) ? (uint64_t(1) << num_rows) - 1 : ~uint64_t(0);
+
+	std::vector<WordVector> words(p_num_outputs, WordVector(num_words, 0));
+	std::vector<uint64_t> x(p_num_inputs);
+	std::vector<uint64_t> y(p_num_outputs);
+
+	for (uint64_t w = 0; w < num_words; w++) {
+		for (int i = 0; i < p_num_inputs; i++) {
+			x[i] = InputPatterns::pattern_word(p_num_inputs, i, w);
+		}
+
+		std::fill(y.begin(), y.end(), 0);
+		p_func(x.data(), y.data());
+
+		for (int j = 0; j < p_num_outputs; j++) {
+			words[j][w] = y[j] & tail;
+		}
+	}
+
+	return words;
+}
+
+/**
+ * @brief Creates a table with the given output columns and generic names.
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::make_table(std::string p_model_name,
+		int p_num_inputs, const std::vector<WordVector> &p_words) {
+
+	TruthTable<T> table;
+
+	table.set_model_name(p_model_name);
+	table.set_output_columns(p_words, uint64_t(1) << p_num_inputs);
+
+	for (int i = 0; i < p_num_inputs; i++) {
+		table.get_input_names().push_back("x" + std::to_string(i));
+	}
+
+	for (size_t j = 0; j < p_words.size(); j++) {
+		table.get_output_names().push_back("y" + std::to_string(j));
+	}
+
+	return table;
+}
+
+/**
+ * @brief Creates the odd parity function of n inputs.
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::parity(int p_num_inputs) {
+
+	int n = p_num_inputs;
+
+	std::vector<WordVector> words = build(n, 1, [n](const uint64_t *x, uint64_t *y) {
+		for (int i = 0; i < n; i++) {
+			y[0] ^= x[i];
+		}
+	});
+
+	return make_table<T>("parity" + std::to_string(n), n, words);
+}
+
+/**
+ * @brief Creates the adder of two n bit operands.
+ *
+ * @details The inputs are the operands a and b, the n + 1 outputs are the sum
+ * including the carry as most significant bit.
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::adder(int p_bits) {
+
+	int n = p_bits;
+
+	std::vector<WordVector> words = build(2 * n, n + 1,
+			[n](const uint64_t *x, uint64_t *y) {
+
+		uint64_t carry = 0;
+
+		// Ripple carry addition from the least significant bit
+		for (int p = 0; p < n; p++) {
+			uint64_t a = x[n - 1 - p];
+			uint64_t b = x[2 * n - 1 - p];
+
+			y[n - p] = a ^ b ^ carry;
+			carry = (a & b) | (carry & (a ^ b));
+		}
+
+		y[0] = carry;
+	});
+
+	return make_table<T>("add" + std::to_string(n), 2 * n, words);
+}
+
+/**
+ * @brief Creates the multiplier of two n bit operands.
+ *
+ * @details The inputs are the operands a and b, the 2n outputs are the product. The
+ * partial products are accumulated by bit-sliced shift and add.
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::multiplier(int p_bits) {
+
+	int n = p_bits;
+
+	std::vector<WordVector> words = build(2 * n, 2 * n,
+			[n](const uint64_t *x, uint64_t *y) {
+
+		// Bit p of the product is stored in output 2n - 1 - p
+		for (int q = 0; q < n; q++) {
+			uint64_t b = x[2 * n - 1 - q];
+			uint64_t carry = 0;
+
+			for (int p = 0; p < n; p++) {
+				uint64_t partial = x[n - 1 - p] & b;
+				uint64_t &acc = y[2 * n - 1 - (p + q)];
+				uint64_t sum = acc ^ partial ^ carry;
+
+				carry = (acc & partial) | (carry & (acc ^ partial));
+				acc = sum;
+			}
+
+			for (int p = n + q; p < 2 * n && carry != 0; p++) {
+				uint64_t &acc = y[2 * n - 1 - p];
+				uint64_t sum = acc ^ carry;
+
+				carry &= acc;
+				acc = sum;
+			}
+		}
+	});
+
+	return make_table<T>("mult" + std::to_string(n), 2 * n, words);
+}
+
+/**
+ * @brief Creates the comparator of two n bit operands.
+ *
+ * @details The inputs are the operands a and b, the outputs are a < b, a = b and a > b.
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::comparator(int p_bits) {
+
+	int n = p_bits;
+
+	std::vector<WordVector> words = build(2 * n, 3,
+			[n](const uint64_t *x, uint64_t *y) {
+
+		uint64_t equal = ~uint64_t(0);
+
+		// The first differing bit from the most significant bit decides
+		for (int p = 0; p < n; p++) {
+			uint64_t a = x[p];
+			uint64_t b = x[n + p];
+
+			y[0] |= equal & ~a & b;
+			y[2] |= equal & a & ~b;
+			equal &= ~(a ^ b);
+		}
+
+		y[1] = equal;
+	});
+
+	return make_table<T>("comp" + std::to_string(n), 2 * n, words);
+}
+
+/**
+ * @brief Creates the multiplexer with k select inputs.
+ *
+ * @details The first k inputs select one of the following 2^k data inputs.
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::multiplexer(int p_select_bits) {
+
+	int k = p_select_bits;
+
+	if (k < 0 || k > 5) {
+		throw std::runtime_error("Number of select inputs is out of range!");
+	}
+
+	int n = k + (1 << k);
+
+	std::vector<WordVector> words = build(n, 1, [k](const uint64_t *x, uint64_t *y) {
+		for (int s = 0; s < (1 << k); s++) {
+			uint64_t selected = x[k + s];
+
+			for (int i = 0; i < k; i++) {
+				selected &= ((s >> (k - 1 - i)) & 1) ? x[i] : ~x[i];
+			}
+
+			y[0] |= selected;
+		}
+	});
+
+	return make_table<T>("mux" + std::to_string(k), n, words);
+}
+
+/**
+ * @brief Creates a random function with uniformly distributed output bits.
+ *
+ * @param p_seed Seed of the Mersenne Twister, equal seeds produce equal tables
+ */
+template<class T>
+TruthTable<T> BenchmarkGenerator::random(int p_num_inputs, int p_num_outputs,
+		uint64_t p_seed) {
+
+	std::mt19937_64 generator(p_seed);
+
+	std::vector<WordVector> words = build(p_num_inputs, p_num_outputs,
+			[p_num_outputs, &generator](const uint64_t*, uint64_t *y) {
+		for (int j = 0; j < p_num_outputs; j++) {
+			y[j] = generator();
+		}
+	});
+
+	return make_table<T>("random" + std::to_string(p_num_inputs), p_num_inputs,
+			words);
+}
+
+/**
+ * @brief Creates the cover of the odd parity function, which consists of 2^(n-1)
+ * minterms and has no smaller cover.
+ */
+inline Cover BenchmarkGenerator::parity_cover(int p_num_inputs) {
+
+	validate_inputs(p_num_inputs);
+
+	Cover cover(p_num_inputs, 1);
+	Cube cube;
+
+	uint64_t num_rows = uint64_t(1) << p_num_inputs;
+
+	cube.care = num_rows - 1;
+	cube.outputs.assign(1, 1);
+
+	for (uint64_t r = 0; r < num_rows; r++) {
+		if (__builtin_popcountll(r) & 1) {
+			cube.value = r;
+			cover.add_cube(cube);
+		}
+	}
+
+	return cover;
+}
+
+/**
+ * @brief Creates the cover of the multiplexer with k select inputs, which consists
+ * of one cube per data input.
+ */
+inline Cover BenchmarkGenerator::multiplexer_cover(int p_select_bits) {
+
+	int k = p_select_bits;
+
+	if (k < 0 || k > 5) {
+		throw std::runtime_error("Number of select inputs is out of range!");
+	}
+
+	int n = k + (1 << k);
+
+	Cover cover(n, 1);
+	Cube cube;
+
+	cube.outputs.assign(1, 1);
+
+	for (int s = 0; s < (1 << k); s++) {
+		// Select inputs are the most significant row bits
+		int data_bit = n - 1 - (k + s);
+
+		cube.care = ((uint64_t(1) << k) - 1) << (1 << k);
+		cube.care |= uint64_t(1) << data_bit;
+		cube.value = (uint64_t(s) << (1 << k)) | (uint64_t(1) << data_bit);
+
+		cover.add_cube(cube);
+	}
+
+	return cover;
+}
+
+/**
+ * @brief Creates the cover of a table which consists of one cube per row of the
+ * ON-set of any output.
+ *
+ * @param p_table Table with packed output columns
+ */
+template<class T>
+Cover BenchmarkGenerator::minterm_cover(const TruthTable<T> &p_table) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	uint64_t num_rows = columns.at(0).rows();
+	int num_inputs = __builtin_ctzll(num_rows);
+	int num_outputs = columns.size();
+
+	Cover cover(num_inputs, num_outputs);
+	Cube cube;
+
+	cube.care = num_rows - 1;
+
+	std::vector<uint64_t> words(num_outputs);
+
+	for (uint64_t w = 0; w < OutputColumn::num_words(num_rows); w++) {
+		uint64_t any = 0;
+
+		for (int j = 0; j < num_outputs; j++) {
+			columns[j].copy_words(w, 1, &words[j]);
+			any |= words[j];
+		}
+
+		// Visit the rows of the word which are in the ON-set of any output
+		while (any != 0) {
+			int b = __builtin_ctzll(any);
+			any &= any - 1;
+
+			cube.value = (w << 6) | b;
+			cube.outputs.assign(LineDecoder::num_words(num_outputs), 0);
+
+			for (int j = 0; j < num_outputs; j++) {
+				cube.outputs[j >> 6] |= ((words[j] >> b) & 1) << (j & 63);
+			}
+
+			cover.add_cube(cube);
+		}
+	}
+
+	return cover;
+}
+
+#endif /* BENCHMARKGENERATOR_H_ */
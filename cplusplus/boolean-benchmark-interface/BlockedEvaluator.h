@@ -0,0 +1,334 @@
+#ifndef BLOCKEDEVALUATOR_H_
+#define BLOCKEDEVALUATOR_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "OutputColumn.h"
+#include "TruthTable.h"
+#include "ParallelFor.h"
+
+/*
+ * @brief Evaluates candidates against all outputs of a table in cache-sized row blocks.
+ *
+ * @details The target columns are stored as tiles: tile b holds the words of rows
+ * block b for all outputs one after another, i.e. output j of tile b starts at word
+ * (b * num_outputs + j) * block_words. A pass over a tile therefore reads one
+ * contiguous range of memory for all outputs, and the error counts of all outputs are
+ * accumulated in the same pass.
+ *
+ * The block size is chosen such that the target, care and candidate tile of a block
+ * fill half of the L2 cache, so the candidate of a block can be computed and compared
+ * while it is still cached. Only with many outputs the tiles grow beyond that, see
+ * default_block_words(). Candidates are either given as complete dense columns, or
+ * produced tile by tile by a callback which is called for each block.
+ *
+ * The blocks are distributed among worker threads, each with its own error counts.
+ */
+class BlockedEvaluator {
+private:
+	int num_outputs;
+	uint64_t num_rows;
+	uint64_t num_words;
+	uint64_t tail;
+
+	uint64_t block_size;
+	uint64_t num_blocks;
+
+	WordVector targets;
+	WordVector cares;
+
+	static uint64_t cache_size(int p_level);
+
+	template<class F>
+	void for_each_block(int p_num_threads, uint64_t *p_errors, F p_func) const;
+
+	void count_block(uint64_t p_block, const uint64_t *p_candidate,
+			uint64_t p_stride, uint64_t *p_errors) const;
+
+public:
+	template<class T>
+	BlockedEvaluator(const TruthTable<T> &p_table, uint64_t p_block_words = 0);
+	virtual ~BlockedEvaluator() = default;
+
+	static uint64_t default_block_words(int p_num_outputs, bool p_has_care);
+
+	int outputs() const;
+	uint64_t rows() const;
+	uint64_t words() const;
+	uint64_t block_words() const;
+	uint64_t blocks() const;
+
+	uint64_t block_begin(uint64_t p_block) const;
+	uint64_t block_count(uint64_t p_block) const;
+	const uint64_t* target_tile(uint64_t p_block) const;
+
+	void count_errors(const uint64_t *p_words, uint64_t *p_errors,
+			int p_num_threads = 1) const;
+
+	template<class G>
+	void evaluate(G p_generate, uint64_t *p_errors, int p_num_threads = 1) const;
+};
+
+/**
+ * @brief Builds the tiles of the target columns and care masks of a table.
+ *
+ * @param p_table Truth table with packed output columns
+ * @param p_block_words Words per output and block, 0 selects default_block_words()
+ */
+template<class T>
+BlockedEvaluator::BlockedEvaluator(const TruthTable<T> &p_table,
+		uint64_t p_block_words) :
+		targets(p_table.get_allocation_policy()), cares(
+				p_table.get_allocation_policy()) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+	const std::vector<OutputColumn> &care_columns = p_table.get_care_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	this->num_outputs = columns.size();
+	this->num_rows = columns.at(0).rows();
+	this->num_words = OutputColumn::num_words(this->num_rows);
+	this->tail = ((this->num_rows & 63) != 0) ?
+			(uint64_t(1) << (this->num_rows & 63)) - 1 : ~uint64_t(0);
+
+	if (p_block_words == 0) {
+		p_block_words = default_block_words(this->num_outputs, care_columns.size() > 0);
+	}
+
+	this->block_size = std::min(p_block_words, this->num_words);
+	this->num_blocks = (this->num_words + this->block_size - 1) / this->block_size;
+
+	uint64_t tile_words = this->num_outputs * this->block_size;
+
+	this->targets.assign(this->num_blocks * tile_words, 0);
+
+	if (care_columns.size() > 0) {
+		this->cares.assign(this->num_blocks * tile_words, 0);
+	}
+
+	for (uint64_t b = 0; b < this->num_blocks; b++) {
+		for (int j = 0; j < this->num_outputs; j++) {
+			uint64_t offset = b * tile_words + j * this->block_size;
+
+			columns[j].copy_words(this->block_begin(b), this->block_count(b),
+					&this->targets[offset]);
+
+			if (care_columns.size() > 0) {
+				care_columns[j].copy_words(this->block_begin(b), this->block_count(b),
+						&this->cares[offset]);
+			}
+		}
+	}
+
+	// The unused bits of the last word are never counted
+	if (care_columns.size() > 0) {
+		uint64_t b = this->num_blocks - 1;
+
+		for (int j = 0; j < this->num_outputs; j++) {
+			this->cares[b * tile_words + j * this->block_size + this->block_count(b) - 1]
+					&= this->tail;
+		}
+	}
+}
+
+/**
+ * @brief Returns the size of a data or unified cache level in bytes.
+ */
+inline uint64_t BlockedEvaluator::cache_size(int p_level) {
+
+	long size = 0;
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+	size = sysconf(p_level == 1 ? _SC_LEVEL1_DCACHE_SIZE : _SC_LEVEL2_CACHE_SIZE);
+#endif
+
+	if (size <= 0) {
+		size = (p_level == 1) ? 32 * 1024 : 1024 * 1024;
+	}
+
+	return size;
+}
+
+/**
+ * @brief Returns the largest power of two of words per output such that the target,
+ * care and candidate tile of a block fill at most half of the L2 cache.
+ *
+ * @details The tile of each output spans at least an eighth of the L1 cache, e.g.
+ * 768 words rounded up to 1024 with a 48 KiB L1 cache. With many outputs the L2
+ * budget would otherwise shrink the tiles until the overhead per block and output
+ * dominates the comparison of the words.
+ */
+inline uint64_t BlockedEvaluator::default_block_words(int p_num_outputs,
+		bool p_has_care) {
+
+	uint64_t streams = std::max(1, p_num_outputs) * (p_has_care ? 3 : 2);
+	uint64_t budget = cache_size(2) / 2 / (streams * sizeof(uint64_t));
+	uint64_t minimum = std::max<uint64_t>(8, cache_size(1) / 8 / sizeof(uint64_t));
+
+	uint64_t words = 1;
+
+	while (2 * words <= budget || words < minimum) {
+		words *= 2;
+	}
+
+	return words;
+}
+
+inline int BlockedEvaluator::outputs() const {
+	return this->num_outputs;
+}
+
+inline uint64_t BlockedEvaluator::rows() const {
+	return this->num_rows;
+}
+
+/**
+ * @brief Returns the number of words of each complete column.
+ */
+inline uint64_t BlockedEvaluator::words() const {
+	return this->num_words;
+}
+
+/**
+ * @brief Returns the number of words per output of a full block.
+ */
+inline uint64_t BlockedEvaluator::block_words() const {
+	return this->block_size;
+}
+
+inline uint64_t BlockedEvaluator::blocks() const {
+	return this->num_blocks;
+}
+
+/**
+ * @brief Returns the index of the first word of a block in the columns.
+ */
+inline uint64_t BlockedEvaluator::block_begin(uint64_t p_block) const {
+	return p_block * this->block_size;
+}
+
+/**
+ * @brief Returns the number of words per output of a block, which is less than
+ * block_words() for the last block.
+ */
+inline uint64_t BlockedEvaluator::block_count(uint64_t p_block) const {
+	return std::min(this->block_size, this->num_words - this->block_begin(p_block));
+}
+
+/**
+ * @brief Returns the target tile of a block, output j starts at word j * block_words().
+ */
+inline const uint64_t* BlockedEvaluator::target_tile(uint64_t p_block) const {
+	return &this->targets[p_block * this->num_outputs * this->block_size];
+}
+
+/**
+ * @brief Adds the errors of the candidate in a block to the error counts of all outputs.
+ *
+ * @param p_candidate Words of the block of output 0 of the candidate
+ * @param p_stride Distance between the words of consecutive outputs
+ */
+inline void BlockedEvaluator::count_block(uint64_t p_block,
+		const uint64_t *p_candidate, uint64_t p_stride, uint64_t *p_errors) const {
+
+	uint64_t count = this->block_count(p_block);
+	uint64_t offset = p_block * this->num_outputs * this->block_size;
+
+	const uint64_t *target = &this->targets[offset];
+	bool last = (p_block == this->num_blocks - 1);
+
+	for (int j = 0; j < this->num_outputs; j++) {
+		const uint64_t *t = target + j * this->block_size;
+		const uint64_t *c = p_candidate + j * p_stride;
+
+		const uint64_t *m = (this->cares.size() > 0) ?
+				&this->cares[offset + j * this->block_size] : nullptr;
+
+		p_errors[j] += OutputColumn::count_differences(c, t, m, count,
+				last ? this->tail : ~uint64_t(0));
+	}
+}
+
+/**
+ * @brief Calls the function for every block on the worker threads.
+ *
+ * @tparam F Callable with the signature void(uint64_t block, uint64_t *errors), where
+ * errors are the error counts of the calling worker
+ *
+ * @param p_errors Receives the sum of the error counts of all workers
+ */
+template<class F>
+void BlockedEvaluator::for_each_block(int p_num_threads, uint64_t *p_errors,
+		F p_func) const {
+
+	std::vector<std::vector<uint64_t>> errors(
+			parallel_workers(this->num_blocks, p_num_threads),
+			std::vector<uint64_t>(this->num_outputs, 0));
+
+	parallel_for(this->num_blocks, p_num_threads, [&](uint64_t p_block, int p_worker) {
+		p_func(p_block, errors[p_worker].data());
+	});
+
+	std::fill(p_errors, p_errors + this->num_outputs, 0);
+
+	for (const std::vector<uint64_t> &counts : errors) {
+		for (int j = 0; j < this->num_outputs; j++) {
+			p_errors[j] += counts[j];
+		}
+	}
+}
+
+/**
+ * @brief Counts the errors of a candidate given as complete dense columns.
+ *
+ * @param p_words Dense columns of all outputs, column j starts at word j * words()
+ * @param p_errors Receives the error count of each output
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+inline void BlockedEvaluator::count_errors(const uint64_t *p_words,
+		uint64_t *p_errors, int p_num_threads) const {
+
+	this->for_each_block(p_num_threads, p_errors,
+			[&](uint64_t p_block, uint64_t *p_counts) {
+		this->count_block(p_block, p_words + this->block_begin(p_block),
+				this->num_words, p_counts);
+	});
+}
+
+/**
+ * @brief Counts the errors of a candidate which is produced block by block.
+ *
+ * @details The candidate never exists as complete columns. Each worker produces the
+ * tile of a block into its own buffer and compares it while it is cached.
+ *
+ * @tparam G Callable with the signature void(uint64_t begin, uint64_t count,
+ * uint64_t *tile), which writes the words begin to begin + count - 1 of every output
+ * j to tile + j * block_words()
+ *
+ * @param p_errors Receives the error count of each output
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+template<class G>
+void BlockedEvaluator::evaluate(G p_generate, uint64_t *p_errors,
+		int p_num_threads) const {
+
+	this->for_each_block(p_num_threads, p_errors,
+			[&](uint64_t p_block, uint64_t *p_counts) {
+		thread_local std::vector<uint64_t> tile;
+
+		tile.resize(this->num_outputs * this->block_size);
+
+		p_generate(this->block_begin(p_block), this->block_count(p_block), tile.data());
+		this->count_block(p_block, tile.data(), this->block_size, p_counts);
+	});
+}
+
+#endif /* BLOCKEDEVALUATOR_H_ */
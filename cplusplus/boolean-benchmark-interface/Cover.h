@@ -0,0 +1,270 @@
+#ifndef COVER_H_
+#define COVER_H_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "OutputColumn.h"
+#include "LineDecoder.h"
+#include "TruthTable.h"
+
+/*
+ * @brief A cube of a multi-output cover.
+ *
+ * @details The input part is stored as value and care mask in row index order,
+ * i.e. bit k refers to bit k of the row index and input 0 is the most significant
+ * bit. A row is covered by the cube if (row & care) == value. Bit j of the output
+ * mask is set if the cube belongs to the ON-set of output j.
+ */
+struct Cube {
+	uint64_t value = 0;
+	uint64_t care = 0;
+
+	std::vector<uint64_t> outputs;
+};
+
+/*
+ * @brief In-memory multi-output cube cover of a Boolean function.
+ *
+ * @details Covers are produced by the benchmark generator and can be written as PLA
+ * file or expanded into the packed output columns of a truth table. The expansion
+ * enumerates only the subspace of each cube, so its cost is proportional to the
+ * number of covered rows instead of the number of rows times the number of cubes.
+ */
+class Cover {
+private:
+	int num_inputs;
+	int num_outputs;
+
+	std::vector<Cube> cubes;
+
+public:
+	Cover(int p_num_inputs = 0, int p_num_outputs = 0);
+	virtual ~Cover() = default;
+
+	void add_cube(const Cube &p_cube);
+	void add_cube(const std::string &p_inputs, const std::string &p_outputs);
+	void remove_cube(int p_index);
+	void clear();
+
+	int get_num_inputs() const;
+	int get_num_outputs() const;
+	int size() const;
+
+	const std::vector<Cube>& get_cubes() const;
+
+	std::string input_string(const Cube &p_cube) const;
+	std::string output_string(const Cube &p_cube) const;
+
+	template<class F>
+	static void for_each_row(const Cube &p_cube, int p_num_inputs, F p_func);
+
+	void expand(std::vector<WordVector> &p_words) const;
+
+	template<class T>
+	void expand(TruthTable<T> &p_table) const;
+};
+
+inline Cover::Cover(int p_num_inputs, int p_num_outputs) {
+
+	if (p_num_inputs < 0 || p_num_inputs > 63) {
+		throw std::runtime_error("Number of inputs exceeds the cover size!");
+	}
+
+	this->num_inputs = p_num_inputs;
+	this->num_outputs = p_num_outputs;
+}
+
+/**
+ * @brief Appends a cube to the cover.
+ *
+ * @details The value and care mask must not have bits above the inputs, and every
+ * bit of the value mask must be a care bit. Otherwise the cube would address rows
+ * outside of the table.
+ */
+inline void Cover::add_cube(const Cube &p_cube) {
+
+	if ((int) p_cube.outputs.size() != LineDecoder::num_words(this->num_outputs)) {
+		throw std::runtime_error("Output mask does not match the number of outputs!");
+	}
+
+	if (((p_cube.care | p_cube.value) >> this->num_inputs) != 0
+			|| (p_cube.value & ~p_cube.care) != 0) {
+		throw std::runtime_error("Cube does not match the inputs of the cover!");
+	}
+
+	this->cubes.push_back(p_cube);
+}
+
+/**
+ * @brief Appends a cube given by the input and output part of a PLA row.
+ *
+ * @param p_inputs Input part consisting of '0', '1' and '-'
+ * @param p_outputs Output part, each '1' assigns the cube to the output
+ */
+inline void Cover::add_cube(const std::string &p_inputs,
+		const std::string &p_outputs) {
+
+	if ((int) p_inputs.size() != this->num_inputs
+			|| (int) p_outputs.size() != this->num_outputs) {
+		throw std::runtime_error("Cube does not match the dimensions of the cover!");
+	}
+
+	Cube cube;
+	uint64_t value = 0;
+	uint64_t care = 0;
+	std::vector<uint64_t> output_care(LineDecoder::num_words(this->num_outputs));
+
+	cube.outputs.resize(output_care.size());
+
+	if (LineDecoder::decode(p_inputs.data(), this->num_inputs, &value, &care) >= 0
+			|| LineDecoder::decode(p_outputs.data(), this->num_outputs,
+					cube.outputs.data(), output_care.data()) >= 0) {
+		throw std::runtime_error("Invalid character in cube!");
+	}
+
+	cube.value = LineDecoder::to_row_order(value, this->num_inputs);
+	cube.care = LineDecoder::to_row_order(care, this->num_inputs);
+
+	this->cubes.push_back(cube);
+}
+
+/**
+ * @brief Removes a cube, the last cube of the cover takes its index.
+ */
+inline void Cover::remove_cube(int p_index) {
+
+	if (p_index < 0 || p_index >= (int) this->cubes.size()) {
+		throw std::runtime_error("Cube index is out of range!");
+	}
+
+	if (p_index != (int) this->cubes.size() - 1) {
+		this->cubes[p_index] = std::move(this->cubes.back());
+	}
+
+	this->cubes.pop_back();
+}
+
+/**
+ * @brief Removes all cubes, the dimensions are kept.
+ */
+inline void Cover::clear() {
+	this->cubes.clear();
+}
+
+inline int Cover::get_num_inputs() const {
+	return this->num_inputs;
+}
+
+inline int Cover::get_num_outputs() const {
+	return this->num_outputs;
+}
+
+/**
+ * @brief Returns the number of cubes of the cover.
+ */
+inline int Cover::size() const {
+	return this->cubes.size();
+}
+
+inline const std::vector<Cube>& Cover::get_cubes() const {
+	return this->cubes;
+}
+
+/**
+ * @brief Returns the input part of a cube as it is written in a PLA row.
+ */
+inline std::string Cover::input_string(const Cube &p_cube) const {
+
+	std::string s(this->num_inputs, '-');
+
+	for (int i = 0; i < this->num_inputs; i++) {
+		int k = this->num_inputs - 1 - i;
+
+		if ((p_cube.care >> k) & 1) {
+			s[i] = ((p_cube.value >> k) & 1) ? '1' : '0';
+		}
+	}
+
+	return s;
+}
+
+/**
+ * @brief Returns the output part of a cube as it is written in a PLA row.
+ */
+inline std::string Cover::output_string(const Cube &p_cube) const {
+
+	std::string s(this->num_outputs, '0');
+
+	for (int j = 0; j < this->num_outputs; j++) {
+		if ((p_cube.outputs[j >> 6] >> (j & 63)) & 1) {
+			s[j] = '1';
+		}
+	}
+
+	return s;
+}
+
+/**
+ * @brief Calls the given function for every row covered by a cube in ascending order.
+ *
+ * @details Enumerates the subsets of the free inputs of the cube.
+ *
+ * @tparam F Callable with the signature void(uint64_t row)
+ */
+template<class F>
+void Cover::for_each_row(const Cube &p_cube, int p_num_inputs, F p_func) {
+
+	uint64_t free = ~p_cube.care & ((uint64_t(1) << p_num_inputs) - 1);
+	uint64_t sub = 0;
+
+	do {
+		p_func(p_cube.value | sub);
+		sub = (sub - free) & free;
+	} while (sub != 0);
+}
+
+/**
+ * @brief Expands the cover into dense bit vectors of the output columns.
+ *
+ * @param p_words Target vectors, one per output
+ */
+inline void Cover::expand(std::vector<WordVector> &p_words) const {
+
+	uint64_t num_rows = uint64_t(1) << this->num_inputs;
+
+	p_words.assign(this->num_outputs,
+			WordVector(OutputColumn::num_words(num_rows), 0));
+
+	for (const Cube &cube : this->cubes) {
+		for (int j = 0; j < this->num_outputs; j++) {
+			if (!((cube.outputs[j >> 6] >> (j & 63)) & 1)) {
+				continue;
+			}
+
+			WordVector &words = p_words[j];
+
+			for_each_row(cube, this->num_inputs, [&words](uint64_t row) {
+				words[row >> 6] |= uint64_t(1) << (row & 63);
+			});
+		}
+	}
+}
+
+/**
+ * @brief Expands the cover into the packed output columns of a truth table.
+ */
+template<class T>
+void Cover::expand(TruthTable<T> &p_table) const {
+
+	std::vector<WordVector> words;
+
+	this->expand(words);
+	p_table.reset();
+	p_table.set_output_columns(words, uint64_t(1) << this->num_inputs);
+}
+
+#endif /* COVER_H_ */
@@ -0,0 +1,273 @@
+#ifndef EDITABLECOVER_H_
+#define EDITABLECOVER_H_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Cover.h"
+#include "OutputColumn.h"
+#include "TruthTable.h"
+
+/*
+ * Storage type of the reference counts, allocated like the table buffers.
+ */
+typedef std::vector<uint32_t, TableAllocator<uint32_t>> CountVector;
+
+/*
+ * @brief Cover whose expanded output columns are updated with every added or removed cube.
+ *
+ * @details For each output, the number of cubes which cover a row is kept as
+ * reference count next to the dense column. Adding a cube increments the counts in
+ * its subspace and sets the rows whose count becomes 1, removing a cube decrements
+ * them and clears the rows whose count drops to 0. An edit therefore costs the number
+ * of rows of the cube times the number of its outputs, independently of the size of
+ * the cover and of the table.
+ *
+ * The reference counts need 4 bytes per row and output in addition to the columns.
+ */
+class EditableCover {
+private:
+	Cover cover;
+
+	uint64_t num_rows;
+
+	std::vector<WordVector> columns;
+	std::vector<CountVector> counts;
+	std::vector<uint64_t> num_ones;
+
+	void apply_cube(const Cube &p_cube, bool p_add);
+
+public:
+	EditableCover(int p_num_inputs, int p_num_outputs,
+			const AllocationPolicy &p_policy = TableMemory::default_policy());
+	EditableCover(const Cover &p_cover,
+			const AllocationPolicy &p_policy = TableMemory::default_policy());
+	virtual ~EditableCover() = default;
+
+	int add_cube(const Cube &p_cube);
+	int add_cube(const std::string &p_inputs, const std::string &p_outputs);
+	void remove_cube(int p_index);
+
+	const Cover& get_cover() const;
+	int size() const;
+	uint64_t rows() const;
+
+	const WordVector& get_column(int p_output) const;
+	bool get(uint64_t p_row, int p_output) const;
+	uint32_t get_count(uint64_t p_row, int p_output) const;
+	uint64_t count_ones(int p_output) const;
+
+	template<class T>
+	uint64_t count_errors(const TruthTable<T> &p_table, int p_output) const;
+
+	template<class T>
+	void apply(TruthTable<T> &p_table) const;
+};
+
+/**
+ * @brief Creates an empty cover with all output columns cleared.
+ */
+inline EditableCover::EditableCover(int p_num_inputs, int p_num_outputs,
+		const AllocationPolicy &p_policy) : cover(p_num_inputs, p_num_outputs) {
+
+	if (p_num_inputs > 32) {
+		throw std::runtime_error("Number of inputs exceeds the table size!");
+	}
+
+	this->num_rows = uint64_t(1) << p_num_inputs;
+
+	uint64_t num_words = OutputColumn::num_words(this->num_rows);
+
+	this->columns.assign(p_num_outputs, WordVector(num_words, 0, p_policy));
+	this->counts.assign(p_num_outputs, CountVector(this->num_rows, 0, p_policy));
+	this->num_ones.assign(p_num_outputs, 0);
+}
+
+/**
+ * @brief Creates an editable copy of a cover, e.g. the cover of a PLA file.
+ *
+ * @see BenchmarkFileReader::get_cover()
+ */
+inline EditableCover::EditableCover(const Cover &p_cover,
+		const AllocationPolicy &p_policy) :
+		EditableCover(p_cover.get_num_inputs(), p_cover.get_num_outputs(), p_policy) {
+
+	for (const Cube &cube : p_cover.get_cubes()) {
+		this->add_cube(cube);
+	}
+}
+
+/**
+ * @brief Updates the reference counts and the columns in the subspace of a cube.
+ */
+inline void EditableCover::apply_cube(const Cube &p_cube, bool p_add) {
+
+	int num_inputs = this->cover.get_num_inputs();
+
+	for (int j = 0; j < this->cover.get_num_outputs(); j++) {
+		if (!((p_cube.outputs[j >> 6] >> (j & 63)) & 1)) {
+			continue;
+		}
+
+		uint32_t *count = this->counts[j].data();
+		uint64_t *words = this->columns[j].data();
+		uint64_t &ones = this->num_ones[j];
+
+		if (p_add) {
+			Cover::for_each_row(p_cube, num_inputs, [&](uint64_t row) {
+				if (count[row]++ == 0) {
+					words[row >> 6] |= uint64_t(1) << (row & 63);
+					ones++;
+				}
+			});
+		} else {
+			Cover::for_each_row(p_cube, num_inputs, [&](uint64_t row) {
+				if (--count[row] == 0) {
+					words[row >> 6] &= ~(uint64_t(1) << (row & 63));
+					ones--;
+				}
+			});
+		}
+	}
+}
+
+/**
+ * @brief Appends a cube and sets the rows it covers.
+ *
+ * @return Index of the cube in the cover
+ */
+inline int EditableCover::add_cube(const Cube &p_cube) {
+
+	this->cover.add_cube(p_cube);
+	this->apply_cube(p_cube, true);
+
+	return this->cover.size() - 1;
+}
+
+/**
+ * @brief Appends a cube given by the input and output part of a PLA row.
+ *
+ * @return Index of the cube in the cover
+ */
+inline int EditableCover::add_cube(const std::string &p_inputs,
+		const std::string &p_outputs) {
+
+	this->cover.add_cube(p_inputs, p_outputs);
+	this->apply_cube(this->cover.get_cubes().back(), true);
+
+	return this->cover.size() - 1;
+}
+
+/**
+ * @brief Removes a cube and clears the rows which are no longer covered.
+ *
+ * @details The last cube of the cover takes the index of the removed cube.
+ */
+inline void EditableCover::remove_cube(int p_index) {
+
+	if (p_index < 0 || p_index >= this->cover.size()) {
+		throw std::runtime_error("Cube index is out of range!");
+	}
+
+	this->apply_cube(this->cover.get_cubes()[p_index], false);
+	this->cover.remove_cube(p_index);
+}
+
+inline const Cover& EditableCover::get_cover() const {
+	return this->cover;
+}
+
+/**
+ * @brief Returns the number of cubes of the cover.
+ */
+inline int EditableCover::size() const {
+	return this->cover.size();
+}
+
+inline uint64_t EditableCover::rows() const {
+	return this->num_rows;
+}
+
+/**
+ * @brief Returns the dense column of an output, which reflects all edits so far.
+ */
+inline const WordVector& EditableCover::get_column(int p_output) const {
+	return this->columns.at(p_output);
+}
+
+/**
+ * @brief Returns whether a row is covered by a cube of the output.
+ */
+inline bool EditableCover::get(uint64_t p_row, int p_output) const {
+	return (this->columns[p_output][p_row >> 6] >> (p_row & 63)) & 1;
+}
+
+/**
+ * @brief Returns the number of cubes of the output which cover a row.
+ */
+inline uint32_t EditableCover::get_count(uint64_t p_row, int p_output) const {
+	return this->counts[p_output][p_row];
+}
+
+/**
+ * @brief Returns the size of the ON-set of an output.
+ */
+inline uint64_t EditableCover::count_ones(int p_output) const {
+	return this->num_ones.at(p_output);
+}
+
+/**
+ * @brief Counts the specified rows of a table output which differ from the column.
+ *
+ * @details The dense column is compared with the packed table in place, so an edit
+ * followed by an evaluation costs one pass over the words of the edited outputs
+ * instead of a repacking of the whole cover with apply().
+ *
+ * @param p_table Table with the same number of rows, e.g. the target function
+ * @param p_output Index of the output in the cover and in the table
+ */
+template<class T>
+uint64_t EditableCover::count_errors(const TruthTable<T> &p_table,
+		int p_output) const {
+
+	if (p_table.get_output_column(p_output).rows() != this->num_rows) {
+		throw std::runtime_error("Table does not match the size of the cover!");
+	}
+
+	return p_table.count_errors(p_output, this->columns.at(p_output).data());
+}
+
+/**
+ * @brief Packs the current columns into the output columns of a truth table.
+ *
+ * @details Names and care masks of the table are kept, rows which are don't cares
+ * in the table are cleared as in the PLA reader. Packing reads every word of all
+ * columns and chooses their representation again, so it should be called when the
+ * table is needed and not after each edit. Use count_errors() to evaluate an edit.
+ */
+template<class T>
+void EditableCover::apply(TruthTable<T> &p_table) const {
+
+	if (!p_table.has_care_columns()) {
+		p_table.set_output_columns(this->columns, this->num_rows);
+		return;
+	}
+
+	std::vector<WordVector> words = this->columns;
+	uint64_t num_words = OutputColumn::num_words(this->num_rows);
+
+	for (size_t j = 0; j < words.size(); j++) {
+		WordVector care;
+		p_table.get_care_column(j).to_words(care);
+
+		for (uint64_t w = 0; w < num_words; w++) {
+			words[j][w] &= care[w];
+		}
+	}
+
+	p_table.set_output_columns(words, this->num_rows);
+}
+
+#endif /* EDITABLECOVER_H_ */
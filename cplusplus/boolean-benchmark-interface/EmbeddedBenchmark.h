@@ -0,0 +1,106 @@
+#ifndef EMBEDDEDBENCHMARK_H_
+#define EMBEDDEDBENCHMARK_H_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "OutputColumn.h"
+#include "TruthTable.h"
+
+/*
+ * @brief Benchmark which is compiled into the program as constant data.
+ *
+ * @details Instances are generated by embed-benchmark from PLA, TT or PLU files, see
+ * the embed target of the Makefile. The output columns are stored dense and one after
+ * another, so column j starts at word j * num_words. The care masks have the same
+ * layout and are nullptr for completely specified functions, the name arrays are
+ * nullptr if the file has no names.
+ *
+ * All members are constant expressions, so the accessors can be evaluated at compile
+ * time and evaluation loops over a fixed benchmark can be specialized on its data.
+ * load() copies the benchmark into a TruthTable for the APIs which expect one.
+ */
+struct EmbeddedBenchmark {
+	const char *model_name;
+
+	int num_inputs;
+	int num_outputs;
+	uint64_t num_rows;
+	uint64_t num_words;
+
+	const uint64_t *words;
+	const uint64_t *care_words;
+
+	const char *const *input_names;
+	const char *const *output_names;
+
+	constexpr const uint64_t* column(int p_output) const {
+		return this->words + p_output * this->num_words;
+	}
+
+	constexpr const uint64_t* care_column(int p_output) const {
+		return this->care_words + p_output * this->num_words;
+	}
+
+	constexpr bool has_care_columns() const {
+		return this->care_words != nullptr;
+	}
+
+	constexpr bool get(uint64_t p_row, int p_output) const {
+		return (this->column(p_output)[p_row >> 6] >> (p_row & 63)) & 1;
+	}
+
+	constexpr bool is_care(uint64_t p_row, int p_output) const {
+		return this->care_words == nullptr
+				|| ((this->care_column(p_output)[p_row >> 6] >> (p_row & 63)) & 1);
+	}
+
+	template<class T>
+	void load(TruthTable<T> &p_table) const;
+};
+
+/**
+ * @brief Packs the embedded columns into a truth table, the rows are not expanded.
+ */
+template<class T>
+void EmbeddedBenchmark::load(TruthTable<T> &p_table) const {
+
+	p_table.clear();
+
+	std::vector<WordVector> columns(this->num_outputs,
+			WordVector(p_table.get_allocation_policy()));
+
+	for (int j = 0; j < this->num_outputs; j++) {
+		columns[j].assign(this->column(j), this->column(j) + this->num_words);
+	}
+
+	p_table.set_output_columns(columns, this->num_rows);
+
+	if (this->has_care_columns()) {
+		for (int j = 0; j < this->num_outputs; j++) {
+			columns[j].assign(this->care_column(j),
+					this->care_column(j) + this->num_words);
+		}
+
+		p_table.set_care_columns(columns, this->num_rows);
+	}
+
+	p_table.set_model_name(this->model_name);
+
+	std::vector<std::string> &input_names = p_table.get_input_names();
+	std::vector<std::string> &output_names = p_table.get_output_names();
+
+	input_names.clear();
+	output_names.clear();
+
+	for (int i = 0; this->input_names != nullptr && i < this->num_inputs; i++) {
+		input_names.push_back(this->input_names[i]);
+	}
+
+	for (int j = 0; this->output_names != nullptr && j < this->num_outputs; j++) {
+		output_names.push_back(this->output_names[j]);
+	}
+}
+
+#endif /* EMBEDDEDBENCHMARK_H_ */
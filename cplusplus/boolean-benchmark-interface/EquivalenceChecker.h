@@ -0,0 +1,258 @@
+#ifndef EQUIVALENCECHECKER_H_
+#define EQUIVALENCECHECKER_H_
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+
+#include "BenchmarkFileReader.h"
+#include "ParallelFor.h"
+
+/*
+ * @brief Outcome of an equivalence check, with the first differing row and output.
+ *
+ * @details Row and output are -1 if the tables are equivalent or their dimensions
+ * differ. The message describes the difference.
+ */
+struct EquivalenceResult {
+	bool equivalent = true;
+
+	int64_t row = -1;
+	int output = -1;
+
+	std::string message;
+};
+
+/*
+ * @brief Checks whether benchmark files or tables encode the same function.
+ *
+ * @details The files are read into packed output columns only, so a check needs two
+ * bits per row and output instead of the row-major tables. The columns are compared
+ * in blocks of BLOCK_WORDS words which are distributed among the worker threads in
+ * ascending order. A block is only compared if it starts before the earliest
+ * mismatch found so far, so the check stops shortly after the first mismatch while
+ * still reporting the lowest differing row.
+ *
+ * Two tables are equivalent if they have the same care rows and the same values in
+ * all care rows. Tables without care masks are completely specified.
+ */
+class EquivalenceChecker {
+private:
+	static constexpr uint64_t BLOCK_WORDS = 1024;
+
+	template<class T>
+	static void read_columns(const std::string &p_file_path, TruthTable<T> &p_table);
+
+public:
+	template<class T>
+	static EquivalenceResult compare(const TruthTable<T> &p_a,
+			const TruthTable<T> &p_b, int p_num_threads = 0);
+
+	static EquivalenceResult compare_files(const std::string &p_file_a,
+			const std::string &p_file_b, int p_num_threads = 0);
+	static std::vector<EquivalenceResult> compare_files(
+			const std::vector<std::string> &p_file_paths, int p_num_threads = 0);
+};
+
+/**
+ * @brief Reads the packed columns of a file without the row-major vectors.
+ */
+template<class T>
+void EquivalenceChecker::read_columns(const std::string &p_file_path,
+		TruthTable<T> &p_table) {
+
+	BenchmarkFileReader<T> reader;
+	reader.set_keep_rows(false);
+	reader.set_num_threads(0);
+	reader.read_file(p_file_path);
+
+	p_table = reader.take_truth_table();
+}
+
+/**
+ * @brief Compares the packed output columns of two tables.
+ *
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+template<class T>
+EquivalenceResult EquivalenceChecker::compare(const TruthTable<T> &p_a,
+		const TruthTable<T> &p_b, int p_num_threads) {
+
+	EquivalenceResult result;
+
+	const std::vector<OutputColumn> &columns_a = p_a.get_output_columns();
+	const std::vector<OutputColumn> &columns_b = p_b.get_output_columns();
+
+	if (columns_a.size() == 0 || columns_b.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	if (columns_a.size() != columns_b.size()
+			|| columns_a.at(0).rows() != columns_b.at(0).rows()) {
+		result.equivalent = false;
+		result.message = "Dimensions differ: "
+				+ std::to_string(columns_a.at(0).rows()) + " x "
+				+ std::to_string(columns_a.size()) + " and "
+				+ std::to_string(columns_b.at(0).rows()) + " x "
+				+ std::to_string(columns_b.size());
+		return result;
+	}
+
+	const std::vector<OutputColumn> &care_a = p_a.get_care_columns();
+	const std::vector<OutputColumn> &care_b = p_b.get_care_columns();
+
+	int num_outputs = columns_a.size();
+	uint64_t num_rows = columns_a.at(0).rows();
+	uint64_t num_words = OutputColumn::num_words(num_rows);
+	uint64_t num_blocks = (num_words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+	uint64_t tail = ((num_rows & 63) != 0) ?
+			(uint64_t(1) << (num_rows & 63)) - 1 : ~uint64_t(0);
+
+	const uint64_t NONE = std::numeric_limits<uint64_t>::max();
+
+	// Blocks are taken in ascending order, the first mismatch is kept as (row, output)
+	std::atomic<uint64_t> first_row(NONE);
+	int first_output = -1;
+	std::mutex result_mutex;
+
+	struct Buffers {
+		std::vector<uint64_t> a;
+		std::vector<uint64_t> b;
+		std::vector<uint64_t> ca;
+		std::vector<uint64_t> cb;
+	};
+
+	std::vector<Buffers> buffers(parallel_workers(num_blocks, p_num_threads));
+
+	parallel_for(num_blocks, p_num_threads, [&](uint64_t p_block, int p_worker) {
+		uint64_t begin = p_block * BLOCK_WORDS;
+		uint64_t count = std::min(BLOCK_WORDS, num_words - begin);
+
+		if ((begin << 6) >= first_row.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		Buffers &buffer = buffers[p_worker];
+
+		if (buffer.a.empty()) {
+			buffer.a.resize(BLOCK_WORDS);
+			buffer.b.resize(BLOCK_WORDS);
+			buffer.ca.assign(BLOCK_WORDS, ~uint64_t(0));
+			buffer.cb.assign(BLOCK_WORDS, ~uint64_t(0));
+		}
+
+		uint64_t block_row = NONE;
+		int block_output = -1;
+
+		for (int j = 0; j < num_outputs; j++) {
+			columns_a[j].copy_words(begin, count, buffer.a.data());
+			columns_b[j].copy_words(begin, count, buffer.b.data());
+
+			if (care_a.size() > 0) {
+				care_a[j].copy_words(begin, count, buffer.ca.data());
+			}
+
+			if (care_b.size() > 0) {
+				care_b[j].copy_words(begin, count, buffer.cb.data());
+			}
+
+			for (uint64_t w = 0; w < count; w++) {
+				// Differing care rows or differing values in a care row
+				uint64_t diff = (buffer.ca[w] ^ buffer.cb[w])
+						| ((buffer.a[w] ^ buffer.b[w]) & buffer.ca[w]);
+
+				if (begin + w == num_words - 1) {
+					diff &= tail;
+				}
+
+				if (diff != 0) {
+					uint64_t row = ((begin + w) << 6) + __builtin_ctzll(diff);
+
+					if (row < block_row) {
+						block_row = row;
+						block_output = j;
+					}
+
+					break;
+				}
+			}
+		}
+
+		if (block_row != NONE) {
+			std::lock_guard<std::mutex> lock(result_mutex);
+
+			if (block_row < first_row.load(std::memory_order_relaxed)) {
+				first_row.store(block_row, std::memory_order_relaxed);
+				first_output = block_output;
+			}
+		}
+	});
+
+	if (first_row.load() != NONE) {
+		result.equivalent = false;
+		result.row = first_row.load();
+		result.output = first_output;
+		result.message = "Output " + std::to_string(result.output) + " differs in row "
+				+ std::to_string(result.row) + ": "
+				+ (p_a.is_care(result.row, result.output) ?
+						std::to_string(columns_a[result.output].get(result.row)) : "-")
+				+ " and "
+				+ (p_b.is_care(result.row, result.output) ?
+						std::to_string(columns_b[result.output].get(result.row)) : "-");
+	}
+
+	return result;
+}
+
+/**
+ * @brief Compares two benchmark files of any format.
+ */
+inline EquivalenceResult EquivalenceChecker::compare_files(
+		const std::string &p_file_a, const std::string &p_file_b, int p_num_threads) {
+
+	TruthTable<int> a;
+	TruthTable<int> b;
+
+	read_columns(p_file_a, a);
+	read_columns(p_file_b, b);
+
+	return compare(a, b, p_num_threads);
+}
+
+/**
+ * @brief Compares every file with the first one, e.g. the PLA, TT and PLU version
+ * of a benchmark.
+ *
+ * @details Only two tables are kept in memory at a time.
+ *
+ * @return Result of the comparison of file k + 1 with the first file at index k
+ */
+inline std::vector<EquivalenceResult> EquivalenceChecker::compare_files(
+		const std::vector<std::string> &p_file_paths, int p_num_threads) {
+
+	std::vector<EquivalenceResult> results;
+
+	if (p_file_paths.size() < 2) {
+		return results;
+	}
+
+	TruthTable<int> reference;
+	read_columns(p_file_paths[0], reference);
+
+	for (size_t k = 1; k < p_file_paths.size(); k++) {
+		TruthTable<int> table;
+		read_columns(p_file_paths[k], table);
+
+		results.push_back(compare(reference, table, p_num_threads));
+	}
+
+	return results;
+}
+
+#endif /* EQUIVALENCECHECKER_H_ */
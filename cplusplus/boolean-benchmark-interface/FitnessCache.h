@@ -0,0 +1,363 @@
+#ifndef FITNESSCACHE_H_
+#define FITNESSCACHE_H_
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+
+#include "OutputColumn.h"
+#include "TruthTable.h"
+
+/*
+ * @brief 128 bit signature of the output columns of a candidate.
+ */
+struct Hash128 {
+	uint64_t low = 0;
+	uint64_t high = 0;
+
+	bool operator==(const Hash128 &p_other) const {
+		return this->low == p_other.low && this->high == p_other.high;
+	}
+};
+
+/*
+ * @brief Bounded concurrent cache of the error counts of evaluated candidates.
+ *
+ * @details A candidate is identified by a 128 bit hash of its dense output columns,
+ * so candidates which compute the same function share one entry regardless of
+ * their structure. The cache belongs to one table and stores the error count of
+ * every output, as returned by TruthTable::count_errors().
+ *
+ * The cache is direct mapped. Each slot is protected by a sequence lock: a lookup
+ * reads the sequence number, the key and the counts, and reports a miss instead of
+ * retrying if the sequence number is odd or has changed in between, so lookups never
+ * block. An insertion claims a slot by incrementing its sequence number to an odd
+ * value and is skipped if another thread holds the slot. Newer entries replace
+ * older ones in the same slot.
+ */
+class FitnessCache {
+private:
+	struct Slot {
+		std::atomic<uint64_t> sequence { 0 };
+		std::atomic<uint64_t> low { 0 };
+		std::atomic<uint64_t> high { 0 };
+	};
+
+	int num_outputs;
+	uint64_t num_rows;
+	uint64_t num_words;
+	uint64_t tail;
+
+	size_t num_slots;
+
+	std::unique_ptr<Slot[]> slots;
+	std::unique_ptr<std::atomic<uint64_t>[]> errors;
+
+	mutable std::atomic<uint64_t> num_hits { 0 };
+	mutable std::atomic<uint64_t> num_misses { 0 };
+
+	size_t slot_index(const Hash128 &p_hash) const;
+
+public:
+	FitnessCache(int p_num_outputs, uint64_t p_num_rows, size_t p_capacity);
+	virtual ~FitnessCache() = default;
+
+	FitnessCache(const FitnessCache&) = delete;
+	FitnessCache& operator=(const FitnessCache&) = delete;
+
+	Hash128 hash(const uint64_t *p_words) const;
+
+	bool lookup(const Hash128 &p_hash, uint64_t *p_errors) const;
+	void insert(const Hash128 &p_hash, const uint64_t *p_errors);
+
+	template<class T>
+	bool evaluate(const TruthTable<T> &p_table, const uint64_t *p_words,
+			uint64_t *p_errors);
+
+	void clear();
+
+	size_t capacity() const;
+	uint64_t hits() const;
+	uint64_t misses() const;
+	double hit_rate() const;
+};
+
+/**
+ * @brief Creates an empty cache.
+ *
+ * @param p_num_outputs Number of outputs of the table
+ * @param p_num_rows Number of rows of the table
+ * @param p_capacity Number of entries, rounded up to a power of two
+ */
+inline FitnessCache::FitnessCache(int p_num_outputs, uint64_t p_num_rows,
+		size_t p_capacity) {
+
+	if (p_num_outputs <= 0 || p_num_rows == 0 || p_capacity == 0) {
+		throw std::runtime_error("Invalid dimensions of the fitness cache!");
+	}
+
+	this->num_outputs = p_num_outputs;
+	this->num_rows = p_num_rows;
+	this->num_words = OutputColumn::num_words(p_num_rows);
+	this->tail = ((p_num_rows & 63) != 0) ?
+			(uint64_t(1) << (p_num_rows & 63)) - 1 : ~uint64_t(0);
+
+	this->num_slots = 1;
+
+	while (this->num_slots < p_capacity) {
+		this->num_slots <<= 1;
+	}
+
+	this->slots.reset(new Slot[this->num_slots]);
+	this->errors.reset(new std::atomic<uint64_t>[this->num_slots * p_num_outputs]);
+
+	for (size_t k = 0; k < this->num_slots * p_num_outputs; k++) {
+		this->errors[k].store(0, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Computes the 128 bit signature of the output columns of a candidate.
+ *
+ * @details The words are hashed column by column in blocks of eight words by four
+ * independent lanes. Each lane multiplies a pair of words keyed with constants to a
+ * 128 bit product, folds it to 64 bits and adds it to its rotated state, so the
+ * lanes don't wait for each other's multiplications. The words themselves are mixed
+ * in as well, so a word which equals its key doesn't cancel the other word of the
+ * pair. The lanes are combined with the MurmurHash3 finalizer.
+ *
+ * Only the last word of each column is masked, so that the unused bits after the
+ * last row don't change the signature. A hit therefore reads every word once and
+ * costs less than counting the errors again.
+ *
+ * @param p_words Dense columns of all outputs, column j starts at word j * num_words
+ */
+inline Hash128 FitnessCache::hash(const uint64_t *p_words) const {
+
+	static const uint64_t KEYS[8] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+			0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL, 0x1d8e4e27c47d124fULL,
+			0x87c37b91114253d5ULL, 0x4cf5ad432745937fULL, 0x9e3779b97f4a7c15ULL };
+
+	auto rotl = [](uint64_t x, int r) {
+		return (x << r) | (x >> (64 - r));
+	};
+
+	auto fold = [](uint64_t a, uint64_t b) {
+		unsigned __int128 product = (unsigned __int128) a * b;
+		return uint64_t(product) ^ uint64_t(product >> 64);
+	};
+
+	auto fmix = [](uint64_t k) {
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdULL;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ULL;
+		k ^= k >> 33;
+		return k;
+	};
+
+	uint64_t lane0 = KEYS[7];
+	uint64_t lane1 = KEYS[6];
+	uint64_t lane2 = KEYS[5];
+	uint64_t lane3 = KEYS[4];
+
+	auto step = [&](uint64_t &p_lane, uint64_t a, uint64_t b, int k) {
+		p_lane = rotl(p_lane, 29) + (fold(a ^ KEYS[k], b ^ KEYS[k + 1]) ^ a ^ rotl(b, 32));
+	};
+
+	auto block = [&](const uint64_t *p_block) {
+		step(lane0, p_block[0], p_block[1], 0);
+		step(lane1, p_block[2], p_block[3], 2);
+		step(lane2, p_block[4], p_block[5], 4);
+		step(lane3, p_block[6], p_block[7], 6);
+	};
+
+	uint64_t last = this->num_words - 1;
+
+	for (int j = 0; j < this->num_outputs; j++) {
+		const uint64_t *column = p_words + j * this->num_words;
+		uint64_t w = 0;
+
+		for (; w + 8 <= last; w += 8) {
+			block(column + w);
+		}
+
+		// The remaining words and the masked last word, padded with zeros
+		uint64_t rest[8] = { 0 };
+
+		std::copy(column + w, column + last, rest);
+		rest[last - w] = column[last] & this->tail;
+
+		block(rest);
+	}
+
+	uint64_t h1 = lane0 + rotl(lane2, 32);
+	uint64_t h2 = lane1 + rotl(lane3, 32);
+
+	h1 ^= this->num_outputs * this->num_words * sizeof(uint64_t);
+
+	h1 += h2;
+	h2 += h1;
+
+	h1 = fmix(h1);
+	h2 = fmix(h2);
+
+	h1 += h2;
+	h2 += h1;
+
+	Hash128 result;
+	result.low = h1;
+	result.high = h2;
+
+	return result;
+}
+
+inline size_t FitnessCache::slot_index(const Hash128 &p_hash) const {
+	return p_hash.low & (this->num_slots - 1);
+}
+
+/**
+ * @brief Looks up the error counts of a candidate without blocking.
+ *
+ * @param p_errors Receives the error count of each output on a hit
+ *
+ * @return True if the candidate is in the cache
+ */
+inline bool FitnessCache::lookup(const Hash128 &p_hash, uint64_t *p_errors) const {
+
+	size_t index = this->slot_index(p_hash);
+	const Slot &slot = this->slots[index];
+	const std::atomic<uint64_t> *counts = &this->errors[index * this->num_outputs];
+
+	uint64_t before = slot.sequence.load(std::memory_order_acquire);
+
+	// Empty slots have the sequence number 0, slots being written an odd one
+	bool hit = before != 0 && (before & 1) == 0
+			&& slot.low.load(std::memory_order_relaxed) == p_hash.low
+			&& slot.high.load(std::memory_order_relaxed) == p_hash.high;
+
+	if (hit) {
+		for (int j = 0; j < this->num_outputs; j++) {
+			p_errors[j] = counts[j].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		hit = slot.sequence.load(std::memory_order_relaxed) == before;
+	}
+
+	if (hit) {
+		this->num_hits.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		this->num_misses.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return hit;
+}
+
+/**
+ * @brief Stores the error counts of a candidate.
+ *
+ * @details The insertion is skipped if another thread is writing the same slot.
+ *
+ * @param p_errors Error count of each output
+ */
+inline void FitnessCache::insert(const Hash128 &p_hash, const uint64_t *p_errors) {
+
+	size_t index = this->slot_index(p_hash);
+	Slot &slot = this->slots[index];
+	std::atomic<uint64_t> *counts = &this->errors[index * this->num_outputs];
+
+	uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+	if ((sequence & 1) != 0 || !slot.sequence.compare_exchange_strong(sequence,
+			sequence + 1, std::memory_order_acquire)) {
+		return;
+	}
+
+	// The data must not become visible before the odd sequence number
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.low.store(p_hash.low, std::memory_order_relaxed);
+	slot.high.store(p_hash.high, std::memory_order_relaxed);
+
+	for (int j = 0; j < this->num_outputs; j++) {
+		counts[j].store(p_errors[j], std::memory_order_relaxed);
+	}
+
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the error counts of a candidate from the cache or computes them.
+ *
+ * @param p_table Table the cache belongs to
+ * @param p_words Dense columns of all outputs, column j starts at word j * num_words
+ * @param p_errors Receives the error count of each output
+ *
+ * @return True if the counts have been taken from the cache
+ */
+template<class T>
+bool FitnessCache::evaluate(const TruthTable<T> &p_table, const uint64_t *p_words,
+		uint64_t *p_errors) {
+
+	if (p_table.num_output_columns() != this->num_outputs
+			|| p_table.get_output_column(0).rows() != this->num_rows) {
+		throw std::runtime_error("Fitness cache doesn't belong to the table!");
+	}
+
+	Hash128 signature = this->hash(p_words);
+
+	if (this->lookup(signature, p_errors)) {
+		return true;
+	}
+
+	for (int j = 0; j < this->num_outputs; j++) {
+		p_errors[j] = p_table.count_errors(j, p_words + j * this->num_words);
+	}
+
+	this->insert(signature, p_errors);
+
+	return false;
+}
+
+/**
+ * @brief Removes all entries and resets the counters. Not thread-safe.
+ */
+inline void FitnessCache::clear() {
+
+	for (size_t k = 0; k < this->num_slots; k++) {
+		this->slots[k].sequence.store(0, std::memory_order_relaxed);
+	}
+
+	this->num_hits.store(0);
+	this->num_misses.store(0);
+}
+
+/**
+ * @brief Returns the number of entries of the cache.
+ */
+inline size_t FitnessCache::capacity() const {
+	return this->num_slots;
+}
+
+inline uint64_t FitnessCache::hits() const {
+	return this->num_hits.load(std::memory_order_relaxed);
+}
+
+inline uint64_t FitnessCache::misses() const {
+	return this->num_misses.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the fraction of lookups which have been answered by the cache.
+ */
+inline double FitnessCache::hit_rate() const {
+	uint64_t lookups = this->hits() + this->misses();
+	return (lookups > 0) ? (double) this->hits() / lookups : 0.0;
+}
+
+#endif /* FITNESSCACHE_H_ */
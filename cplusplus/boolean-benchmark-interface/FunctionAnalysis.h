@@ -0,0 +1,375 @@
+#ifndef FUNCTIONANALYSIS_H_
+#define FUNCTIONANALYSIS_H_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
+
+#include "BenchmarkFileReader.h"
+#include "FunctionView.h"
+#include "ParallelFor.h"
+
+/*
+ * @brief Functional properties of a single output.
+ *
+ * @details The masks are indexed by input, i.e. bit i refers to input i of the table.
+ * An input which is not in the support is both positive and negative unate.
+ */
+struct OutputSummary {
+	uint64_t ones = 0;
+	bool balanced = false;
+
+	uint64_t support_mask = 0;
+	uint64_t positive_unate_mask = 0;
+	uint64_t negative_unate_mask = 0;
+
+	std::vector<std::pair<int, int>> symmetric_pairs;
+};
+
+/*
+ * @brief Functional properties of all outputs of a benchmark.
+ */
+struct BenchmarkSummary {
+	std::string model_name;
+
+	int num_inputs = 0;
+	int num_outputs = 0;
+
+	std::vector<OutputSummary> outputs;
+
+	bool depends(int p_output, int p_input) const;
+	bool is_unate(int p_output) const;
+};
+
+/*
+ * @brief Computes support sets, symmetric input pairs, unateness and balance of the
+ * outputs of a truth table.
+ *
+ * @details All properties are derived from cofactors which are compared word by word
+ * on the packed output columns. The cofactors are produced by FunctionView, so no
+ * column is copied as a whole. The outputs are analyzed in parallel.
+ *
+ * The summary can be cached in a text file next to the benchmark file, which is
+ * invalidated when the benchmark file is modified.
+ */
+class FunctionAnalysis {
+private:
+	static bool equal(const WordVector &p_a, const WordVector &p_b);
+	static bool subset(const WordVector &p_a, const WordVector &p_b);
+
+public:
+	static OutputSummary analyze_output(const OutputColumn &p_column);
+	template<class T>
+	static BenchmarkSummary analyze(const TruthTable<T> &p_table,
+			int p_num_threads = 0);
+
+	static std::string cache_path(std::string p_file_path);
+	static bool load_summary(std::string p_file_path,
+			BenchmarkSummary &p_summary);
+	static void save_summary(std::string p_file_path,
+			const BenchmarkSummary &p_summary);
+
+	static BenchmarkSummary analyze_file(std::string p_file_path,
+			bool p_use_cache = true, int p_num_threads = 0);
+};
+
+/**
+ * @brief Checks whether an output depends on an input.
+ */
+inline bool BenchmarkSummary::depends(int p_output, int p_input) const {
+	return (this->outputs.at(p_output).support_mask >> p_input) & 1;
+}
+
+/**
+ * @brief Checks whether an output is positive or negative unate in every input.
+ */
+inline bool BenchmarkSummary::is_unate(int p_output) const {
+	const OutputSummary &summary = this->outputs.at(p_output);
+	return (summary.positive_unate_mask | summary.negative_unate_mask)
+			== (uint64_t(1) << this->num_inputs) - 1;
+}
+
+/**
+ * @brief Checks two bit vectors of equal size for equality.
+ */
+inline bool FunctionAnalysis::equal(const WordVector &p_a,
+		const WordVector &p_b) {
+
+	uint64_t diff = 0;
+
+	for (size_t i = 0; i < p_a.size(); i++) {
+		diff |= p_a[i] ^ p_b[i];
+	}
+
+	return diff == 0;
+}
+
+/**
+ * @brief Checks whether the ON-set of the first bit vector is contained in the second.
+ */
+inline bool FunctionAnalysis::subset(const WordVector &p_a,
+		const WordVector &p_b) {
+
+	uint64_t diff = 0;
+
+	for (size_t i = 0; i < p_a.size(); i++) {
+		diff |= p_a[i] & ~p_b[i];
+	}
+
+	return diff == 0;
+}
+
+/**
+ * @brief Computes the functional properties of a single output column.
+ *
+ * @param p_column Output column whose number of rows is a power of two
+ */
+inline OutputSummary FunctionAnalysis::analyze_output(
+		const OutputColumn &p_column) {
+
+	OutputSummary summary;
+	FunctionView view(p_column);
+
+	int n = view.inputs();
+
+	if (n > 63) {
+		throw std::runtime_error("Number of inputs exceeds the summary masks!");
+	}
+
+	summary.ones = p_column.count_ones();
+	summary.balanced = (n > 0) && (summary.ones == (p_column.rows() >> 1));
+
+	WordVector f0;
+	WordVector f1;
+
+	// Support and unateness from the cofactors of each input
+	for (int i = 0; i < n; i++) {
+		view.cofactor(i, false).materialize(f0);
+		view.cofactor(i, true).materialize(f1);
+
+		uint64_t bit = uint64_t(1) << i;
+
+		if (!equal(f0, f1)) {
+			summary.support_mask |= bit;
+		}
+
+		if (subset(f0, f1)) {
+			summary.positive_unate_mask |= bit;
+		}
+
+		if (subset(f1, f0)) {
+			summary.negative_unate_mask |= bit;
+		}
+	}
+
+	// Inputs i < j are symmetric if f|xi=0,xj=1 equals f|xi=1,xj=0
+	for (int i = 0; i < n; i++) {
+		FunctionView fi0 = view.cofactor(i, false);
+		FunctionView fi1 = view.cofactor(i, true);
+
+		for (int j = i + 1; j < n; j++) {
+			uint64_t bit_i = uint64_t(1) << i;
+			uint64_t bit_j = uint64_t(1) << j;
+
+			// Inputs outside the support are trivially symmetric to each other
+			if (!(summary.support_mask & bit_i)
+					&& !(summary.support_mask & bit_j)) {
+				summary.symmetric_pairs.emplace_back(i, j);
+				continue;
+			}
+
+			// Input j has index j - 1 in the cofactors of input i
+			fi0.cofactor(j - 1, true).materialize(f0);
+			fi1.cofactor(j - 1, false).materialize(f1);
+
+			if (equal(f0, f1)) {
+				summary.symmetric_pairs.emplace_back(i, j);
+			}
+		}
+	}
+
+	return summary;
+}
+
+/**
+ * @brief Computes the functional properties of all outputs of a table.
+ *
+ * @details Requires the packed output columns of the table. The properties are
+ * only defined for completely specified functions, so tables with don't cares are
+ * rejected instead of treating the don't cares as 0.
+ *
+ * @param p_table Truth table which has been read from a TT or PLA file
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+template<class T>
+BenchmarkSummary FunctionAnalysis::analyze(const TruthTable<T> &p_table,
+		int p_num_threads) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	if (p_table.has_care_columns()) {
+		throw std::runtime_error("Truth table has don't care rows!");
+	}
+
+	BenchmarkSummary summary;
+	summary.num_outputs = columns.size();
+	summary.num_inputs = __builtin_ctzll(columns.at(0).rows());
+	summary.outputs.resize(columns.size());
+
+	parallel_for(columns.size(), p_num_threads, [&](uint64_t p_output, int) {
+		summary.outputs[p_output] = analyze_output(columns[p_output]);
+	});
+
+	return summary;
+}
+
+/**
+ * @brief Returns the path of the summary cache which belongs to a benchmark file.
+ */
+inline std::string FunctionAnalysis::cache_path(std::string p_file_path) {
+	return p_file_path + ".summary";
+}
+
+/**
+ * @brief Loads the cached summary of a benchmark file.
+ *
+ * @param p_file_path Path of the benchmark file
+ * @param p_summary Target summary
+ *
+ * @return False if there is no cache or the benchmark file is newer than the cache
+ */
+inline bool FunctionAnalysis::load_summary(std::string p_file_path,
+		BenchmarkSummary &p_summary) {
+
+	std::string path = cache_path(p_file_path);
+
+	if (!std::filesystem::exists(path)
+			|| std::filesystem::last_write_time(path)
+					< std::filesystem::last_write_time(p_file_path)) {
+		return false;
+	}
+
+	std::ifstream ifs(path);
+	std::string line;
+	std::string keyword;
+
+	BenchmarkSummary summary;
+
+	while (std::getline(ifs, line)) {
+		std::stringstream sstream(line);
+		sstream >> keyword;
+
+		if (keyword == ".model") {
+			sstream >> summary.model_name;
+		} else if (keyword == ".i") {
+			sstream >> summary.num_inputs;
+		} else if (keyword == ".o") {
+			sstream >> summary.num_outputs;
+		} else if (keyword == ".out") {
+			OutputSummary output;
+			int balanced;
+			int i;
+			int j;
+			char separator;
+
+			sstream >> output.ones >> balanced >> std::hex >> output.support_mask
+					>> output.positive_unate_mask >> output.negative_unate_mask
+					>> std::dec;
+
+			output.balanced = balanced;
+
+			while (sstream >> i >> separator >> j) {
+				output.symmetric_pairs.emplace_back(i, j);
+			}
+
+			summary.outputs.push_back(output);
+		}
+	}
+
+	if (summary.num_outputs != (int) summary.outputs.size()) {
+		return false;
+	}
+
+	p_summary = summary;
+	return true;
+}
+
+/**
+ * @brief Writes the summary of a benchmark file to its cache file.
+ *
+ * @details The format follows the header keywords of the benchmark files. Each output
+ * is stored in one .out line with the ON-set size, the balance flag, the hexadecimal
+ * support and unateness masks and the symmetric pairs.
+ */
+inline void FunctionAnalysis::save_summary(std::string p_file_path,
+		const BenchmarkSummary &p_summary) {
+
+	std::ofstream ofs(cache_path(p_file_path));
+
+	if (!ofs.is_open()) {
+		throw std::runtime_error("Cannot open summary cache file!");
+	}
+
+	if (p_summary.model_name.length() > 0) {
+		ofs << ".model " << p_summary.model_name << "\n";
+	}
+
+	ofs << ".i " << p_summary.num_inputs << "\n";
+	ofs << ".o " << p_summary.num_outputs << "\n";
+
+	for (const OutputSummary &output : p_summary.outputs) {
+		ofs << ".out " << output.ones << " " << output.balanced << std::hex
+				<< " " << output.support_mask << " "
+				<< output.positive_unate_mask << " "
+				<< output.negative_unate_mask << std::dec;
+
+		for (const std::pair<int, int> &pair : output.symmetric_pairs) {
+			ofs << " " << pair.first << ":" << pair.second;
+		}
+
+		ofs << "\n";
+	}
+
+	ofs << ".e\n";
+}
+
+/**
+ * @brief Returns the summary of a benchmark file, using the cache if it is valid.
+ *
+ * @param p_file_path Path of a TT or PLA benchmark file
+ * @param p_use_cache Load and store the summary next to the file
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+inline BenchmarkSummary FunctionAnalysis::analyze_file(std::string p_file_path,
+		bool p_use_cache, int p_num_threads) {
+
+	BenchmarkSummary summary;
+
+	if (p_use_cache && load_summary(p_file_path, summary)) {
+		return summary;
+	}
+
+	BenchmarkFileReader<int> reader;
+	reader.set_keep_rows(false);
+	reader.read_file(p_file_path);
+
+	summary = analyze(reader.get_truth_table(), p_num_threads);
+	summary.model_name = reader.get_model_name();
+
+	if (p_use_cache) {
+		save_summary(p_file_path, summary);
+	}
+
+	return summary;
+}
+
+#endif /* FUNCTIONANALYSIS_H_ */
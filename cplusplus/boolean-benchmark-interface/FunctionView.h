@@ -0,0 +1,353 @@
+#ifndef FUNCTIONVIEW_H_
+#define FUNCTIONVIEW_H_
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "OutputColumn.h"
+
+/*
+ * @brief Presents a cofactor or an input permutation of an output column without copying it.
+ *
+ * @details A view maps each of its rows to a row of the underlying column. The fixed
+ * inputs of a cofactor are stored as constant bits of the base row index, the remaining
+ * inputs are scattered to their positions in the base row index. Views can be nested
+ * arbitrarily, e.g. the cofactor of a permuted cofactor, and never own any table data.
+ * The view stays valid as long as the column it refers to.
+ *
+ * As in the truth table, input 0 is the most significant bit of the row index.
+ *
+ * When the positions of the remaining inputs are in ascending order, the view is
+ * materialized by strided word access for dense columns, combined with a bit extract
+ * for the inputs of the lowest six row bits.
+ */
+class FunctionView {
+private:
+	const OutputColumn *column;
+
+	int num_vars;
+
+	// Bits of the base row index which are fixed by cofactors
+	uint64_t fixed_bits;
+
+	// Bits of the base row index which are mapped to the view
+	uint64_t free_mask;
+
+	// Position in the base row index of bit k of the view row index
+	uint8_t positions[64];
+
+	// Positions are ascending, so the mapping is a bit deposit into free_mask
+	bool ordered;
+
+	static uint64_t extract_bits(uint64_t p_word, uint64_t p_mask);
+
+	template<class F>
+	void for_each_word(F p_func) const;
+
+public:
+	FunctionView(const OutputColumn &p_column);
+	virtual ~FunctionView() = default;
+
+	FunctionView cofactor(int p_input, bool p_value) const;
+	FunctionView permute(const std::vector<int> &p_permutation) const;
+
+	int inputs() const;
+	uint64_t rows() const;
+	bool is_ordered() const;
+
+	uint64_t base_row(uint64_t p_row) const;
+	bool get(uint64_t p_row) const;
+	uint64_t count_ones() const;
+
+	void materialize(WordVector &p_words) const;
+	OutputColumn to_column() const;
+};
+
+/**
+ * @brief Creates the identity view of an output column.
+ *
+ * @param p_column Output column whose number of rows is a power of two
+ */
+inline FunctionView::FunctionView(const OutputColumn &p_column) {
+
+	uint64_t num_rows = p_column.rows();
+
+	if (num_rows == 0 || (num_rows & (num_rows - 1)) != 0) {
+		throw std::runtime_error("Number of rows is not a power of two!");
+	}
+
+	this->column = &p_column;
+	this->num_vars = __builtin_ctzll(num_rows);
+	this->fixed_bits = 0;
+	this->free_mask = num_rows - 1;
+	this->ordered = true;
+
+	for (int k = 0; k < this->num_vars; k++) {
+		this->positions[k] = k;
+	}
+}
+
+/**
+ * @brief Returns the Shannon cofactor of the view with respect to an input.
+ *
+ * @param p_input Index of the input within the view
+ * @param p_value Value the input is fixed to
+ *
+ * @return View with one input less
+ */
+inline FunctionView FunctionView::cofactor(int p_input, bool p_value) const {
+
+	if (p_input < 0 || p_input >= this->num_vars) {
+		throw std::runtime_error("Input index is out of range!");
+	}
+
+	FunctionView view = *this;
+
+	int k = this->num_vars - 1 - p_input;
+	uint64_t bit = uint64_t(1) << this->positions[k];
+
+	view.free_mask &= ~bit;
+
+	if (p_value) {
+		view.fixed_bits |= bit;
+	}
+
+	// Remove the row bit of the input, the lower bits keep their positions
+	for (int i = k; i < this->num_vars - 1; i++) {
+		view.positions[i] = this->positions[i + 1];
+	}
+
+	view.num_vars--;
+
+	return view;
+}
+
+/**
+ * @brief Returns a view with reordered inputs.
+ *
+ * @param p_permutation Input i of the new view is input p_permutation[i] of this view
+ *
+ * @return View with the same number of inputs
+ */
+inline FunctionView FunctionView::permute(
+		const std::vector<int> &p_permutation) const {
+
+	if ((int) p_permutation.size() != this->num_vars) {
+		throw std::runtime_error("Permutation does not match the number of inputs!");
+	}
+
+	FunctionView view = *this;
+	uint64_t seen = 0;
+	int m = this->num_vars;
+
+	for (int i = 0; i < m; i++) {
+		int source = p_permutation[i];
+
+		if (source < 0 || source >= m || ((seen >> source) & 1)) {
+			throw std::runtime_error("Invalid permutation of the inputs!");
+		}
+
+		seen |= uint64_t(1) << source;
+		view.positions[m - 1 - i] = this->positions[m - 1 - source];
+	}
+
+	view.ordered = true;
+
+	for (int k = 1; k < m; k++) {
+		if (view.positions[k - 1] > view.positions[k]) {
+			view.ordered = false;
+		}
+	}
+
+	return view;
+}
+
+/**
+ * @brief Returns the number of inputs of the view.
+ */
+inline int FunctionView::inputs() const {
+	return this->num_vars;
+}
+
+/**
+ * @brief Returns the number of rows of the view.
+ */
+inline uint64_t FunctionView::rows() const {
+	return uint64_t(1) << this->num_vars;
+}
+
+/**
+ * @brief Returns whether the view rows map to the base rows in ascending order.
+ */
+inline bool FunctionView::is_ordered() const {
+	return this->ordered;
+}
+
+/**
+ * @brief Maps a row of the view to the row of the underlying column.
+ */
+inline uint64_t FunctionView::base_row(uint64_t p_row) const {
+
+#if defined(__BMI2__)
+	if (this->ordered) {
+		return this->fixed_bits | _pdep_u64(p_row, this->free_mask);
+	}
+#endif
+
+	uint64_t row = this->fixed_bits;
+
+	for (int k = 0; k < this->num_vars; k++) {
+		row |= ((p_row >> k) & 1) << this->positions[k];
+	}
+
+	return row;
+}
+
+/**
+ * @brief Returns the value of the function at a row of the view.
+ */
+inline bool FunctionView::get(uint64_t p_row) const {
+	return this->column->get(this->base_row(p_row));
+}
+
+/**
+ * @brief Extracts the bits of a word selected by the mask into the low bits.
+ */
+inline uint64_t FunctionView::extract_bits(uint64_t p_word, uint64_t p_mask) {
+
+#if defined(__BMI2__)
+	return _pext_u64(p_word, p_mask);
+#else
+	if (p_mask == ~uint64_t(0)) {
+		return p_word;
+	}
+
+	uint64_t result = 0;
+	int i = 0;
+
+	while (p_mask != 0) {
+		result |= ((p_word >> __builtin_ctzll(p_mask)) & 1) << i++;
+		p_mask &= p_mask - 1;
+	}
+
+	return result;
+#endif
+}
+
+/**
+ * @brief Calls the given function with the dense words of the view in ascending order.
+ *
+ * @tparam F Callable with the signature void(uint64_t word)
+ */
+template<class F>
+void FunctionView::for_each_word(F p_func) const {
+
+	uint64_t num_rows = this->rows();
+
+	if (this->ordered
+			&& this->column->get_representation() == OutputColumn::DENSE) {
+
+		const WordVector &data = this->column->get_data();
+
+		// Bits within a base word which belong to the view
+		uint64_t low_free = this->free_mask & 63;
+		uint64_t low_fixed = this->fixed_bits & 63;
+		uint64_t select = 0;
+
+		for (uint64_t p = 0; p < 64; p++) {
+			if ((p & ~low_free) == low_fixed) {
+				select |= uint64_t(1) << p;
+			}
+		}
+
+		int chunk = __builtin_popcountll(select);
+
+		// Base words which belong to the view
+		uint64_t high_free = this->free_mask >> 6;
+		uint64_t high_fixed = this->fixed_bits >> 6;
+		uint64_t sub = 0;
+
+		uint64_t word = 0;
+		int fill = 0;
+
+		// Enumerate the subsets of high_free in ascending order
+		do {
+			word |= extract_bits(data[high_fixed | sub], select) << fill;
+			fill += chunk;
+
+			if (fill == 64) {
+				p_func(word);
+				word = 0;
+				fill = 0;
+			}
+
+			sub = (sub - high_free) & high_free;
+		} while (sub != 0);
+
+		if (fill > 0) {
+			p_func(word);
+		}
+
+		return;
+	}
+
+	uint64_t word = 0;
+
+	for (uint64_t r = 0; r < num_rows; r++) {
+		if (this->get(r)) {
+			word |= uint64_t(1) << (r & 63);
+		}
+
+		if ((r & 63) == 63 || r == num_rows - 1) {
+			p_func(word);
+			word = 0;
+		}
+	}
+}
+
+/**
+ * @brief Returns the number of rows of the ON-set of the view.
+ */
+inline uint64_t FunctionView::count_ones() const {
+
+	uint64_t count = 0;
+
+	this->for_each_word([&count](uint64_t word) {
+		count += __builtin_popcountll(word);
+	});
+
+	return count;
+}
+
+/**
+ * @brief Copies the function of the view into a dense bit vector.
+ *
+ * @param p_words Target vector, resized to OutputColumn::num_words(rows())
+ */
+inline void FunctionView::materialize(WordVector &p_words) const {
+
+	p_words.clear();
+	p_words.reserve(OutputColumn::num_words(this->rows()));
+
+	this->for_each_word([&p_words](uint64_t word) {
+		p_words.push_back(word);
+	});
+}
+
+/**
+ * @brief Materializes the view as a new output column.
+ *
+ * @details The representation of the column is chosen by density.
+ */
+inline OutputColumn FunctionView::to_column() const {
+	WordVector words;
+	this->materialize(words);
+	return OutputColumn(words, this->rows());
+}
+
+#endif /* FUNCTIONVIEW_H_ */
@@ -0,0 +1,289 @@
+#ifndef INPUTPATTERNCACHE_H_
+#define INPUTPATTERNCACHE_H_
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <stdexcept>
+
+#include "OutputColumn.h"
+
+/*
+ * @brief Bit-packed input columns of the complete truth table with n inputs.
+ *
+ * @details The columns use the layout of the dense output columns: bit r % 64 of
+ * word r / 64 is the value of the input in row r. Input 0 is the most significant
+ * bit of the row index. The columns of all inputs are stored in one contiguous
+ * buffer, so the columns of the inputs are at a fixed stride.
+ */
+class InputPatterns {
+private:
+	int num_inputs;
+	uint64_t num_rows;
+	uint64_t num_words;
+
+	WordVector data;
+
+public:
+	InputPatterns(int p_num_inputs);
+	virtual ~InputPatterns() = default;
+
+	InputPatterns(const InputPatterns&) = delete;
+	InputPatterns& operator=(const InputPatterns&) = delete;
+
+	static uint64_t pattern_word(int p_num_inputs, int p_input, uint64_t p_word);
+
+	int inputs() const;
+	uint64_t rows() const;
+	uint64_t words() const;
+
+	const uint64_t* column(int p_input) const;
+	uint64_t get(uint64_t p_row, int p_input) const;
+
+	uint64_t memory_usage() const;
+};
+
+/*
+ * @brief Process-wide cache of the input columns for each number of inputs.
+ *
+ * @details Every complete truth table with n inputs has the same input columns, so
+ * they are built once on first request and shared read-only by all tables and
+ * evaluators of that arity. The cache is thread-safe; concurrent first requests
+ * for the same arity build the columns only once. The columns stay cached for the
+ * lifetime of the process.
+ *
+ * The row-major input vectors of TruthTable::get_inputs() are expanded from the
+ * packed columns on request and shared the same way. They are released when the
+ * last table which uses them is destroyed.
+ */
+class InputPatternCache {
+private:
+	struct Entry {
+		std::once_flag flag;
+		std::shared_ptr<const InputPatterns> patterns;
+	};
+
+	static Entry& entry(int p_num_inputs);
+
+public:
+	static const int MAX_INPUTS = 40;
+
+	static std::shared_ptr<const InputPatterns> get(int p_num_inputs);
+	static bool is_cached(int p_num_inputs);
+
+	template<class T>
+	static std::shared_ptr<const std::vector<std::vector<T>>> rows(int p_num_inputs);
+
+	static uint64_t memory_usage();
+};
+
+/**
+ * @brief Builds the input columns of the table with n inputs.
+ */
+inline InputPatterns::InputPatterns(int p_num_inputs) {
+
+	if (p_num_inputs < 0 || p_num_inputs > InputPatternCache::MAX_INPUTS) {
+		throw std::runtime_error("Number of inputs is out of range!");
+	}
+
+	this->num_inputs = p_num_inputs;
+	this->num_rows = uint64_t(1) << p_num_inputs;
+	this->num_words = OutputColumn::num_words(this->num_rows);
+	this->data.resize(this->num_inputs * this->num_words);
+
+	// Tables with less than 64 rows only use the low bits of their word
+	uint64_t tail = (this->num_rows < 64) ?
+			(uint64_t(1) << this->num_rows) - 1 : ~uint64_t(0);
+
+	for (int i = 0; i < this->num_inputs; i++) {
+		uint64_t *words = this->data.data() + i * this->num_words;
+		int k = this->num_inputs - 1 - i;
+
+		if (k < 6) {
+			std::fill(words, words + this->num_words,
+					pattern_word(this->num_inputs, i, 0) & tail);
+			continue;
+		}
+
+		// Higher row bits alternate in runs of 2^(k - 6) words
+		uint64_t run = uint64_t(1) << (k - 6);
+
+		for (uint64_t w = 0; w < this->num_words; w += run) {
+			std::fill(words + w, words + w + run,
+					pattern_word(this->num_inputs, i, w));
+		}
+	}
+}
+
+/**
+ * @brief Returns the values of an input in the rows of a word.
+ *
+ * @param p_num_inputs Number of inputs of the table
+ * @param p_input Index of the input
+ * @param p_word Index of the word, i.e. the rows 64 * p_word to 64 * p_word + 63
+ */
+inline uint64_t InputPatterns::pattern_word(int p_num_inputs, int p_input,
+		uint64_t p_word) {
+
+	// Bit k of the row index alternates in blocks of 2^k rows
+	static const uint64_t patterns[6] = {
+		0xAAAAAAAAAAAAAAAAULL,
+		0xCCCCCCCCCCCCCCCCULL,
+		0xF0F0F0F0F0F0F0F0ULL,
+		0xFF00FF00FF00FF00ULL,
+		0xFFFF0000FFFF0000ULL,
+		0xFFFFFFFF00000000ULL
+	};
+
+	int k = p_num_inputs - 1 - p_input;
+
+	if (k < 6) {
+		return patterns[k];
+	}
+
+	// Higher row bits are constant within a word
+	return ((p_word >> (k - 6)) & 1) ? ~uint64_t(0) : 0;
+}
+
+inline int InputPatterns::inputs() const {
+	return this->num_inputs;
+}
+
+inline uint64_t InputPatterns::rows() const {
+	return this->num_rows;
+}
+
+/**
+ * @brief Returns the number of words of each column.
+ */
+inline uint64_t InputPatterns::words() const {
+	return this->num_words;
+}
+
+/**
+ * @brief Returns the packed column of an input.
+ *
+ * @param p_input Index of the input, 0 <= p_input < inputs()
+ */
+inline const uint64_t* InputPatterns::column(int p_input) const {
+	assert((p_input >= 0) && (p_input < this->num_inputs));
+	return this->data.data() + p_input * this->num_words;
+}
+
+/**
+ * @brief Returns the value of an input at a row.
+ */
+inline uint64_t InputPatterns::get(uint64_t p_row, int p_input) const {
+	return (this->column(p_input)[p_row >> 6] >> (p_row & 63)) & 1;
+}
+
+/**
+ * @brief Returns the number of bytes of the packed columns.
+ */
+inline uint64_t InputPatterns::memory_usage() const {
+	return this->data.size() * sizeof(uint64_t);
+}
+
+/**
+ * @brief Returns the cache slot of an arity.
+ *
+ * @details The slots are a function-local static, so all translation units of a
+ * program share one cache.
+ */
+inline InputPatternCache::Entry& InputPatternCache::entry(int p_num_inputs) {
+
+	static Entry entries[MAX_INPUTS + 1];
+
+	if (p_num_inputs < 0 || p_num_inputs > MAX_INPUTS) {
+		throw std::runtime_error("Number of inputs is out of range!");
+	}
+
+	return entries[p_num_inputs];
+}
+
+/**
+ * @brief Returns the shared input columns for n inputs, building them on first use.
+ */
+inline std::shared_ptr<const InputPatterns> InputPatternCache::get(
+		int p_num_inputs) {
+
+	Entry &slot = entry(p_num_inputs);
+
+	std::call_once(slot.flag, [&slot, p_num_inputs]() {
+		std::atomic_store(&slot.patterns,
+				std::shared_ptr<const InputPatterns>(
+						std::make_shared<const InputPatterns>(p_num_inputs)));
+	});
+
+	return std::atomic_load(&slot.patterns);
+}
+
+/**
+ * @brief Returns the shared row-major input vectors for n inputs.
+ *
+ * @details Row r holds the values of all inputs in row r. The vectors are built
+ * from the packed columns if no table holds them at the moment.
+ *
+ * @tparam T Value type of the rows, as in TruthTable
+ */
+template<class T>
+std::shared_ptr<const std::vector<std::vector<T>>> InputPatternCache::rows(
+		int p_num_inputs) {
+
+	static std::mutex mutex;
+	static std::weak_ptr<const std::vector<std::vector<T>>> slots[MAX_INPUTS + 1];
+
+	std::shared_ptr<const InputPatterns> patterns = get(p_num_inputs);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::shared_ptr<const std::vector<std::vector<T>>> rows =
+			slots[p_num_inputs].lock();
+
+	if (!rows) {
+		std::shared_ptr<std::vector<std::vector<T>>> table = std::make_shared<
+				std::vector<std::vector<T>>>(patterns->rows(),
+				std::vector<T>(p_num_inputs, 0));
+
+		for (int i = 0; i < p_num_inputs; i++) {
+			for (uint64_t r = 0; r < patterns->rows(); r++) {
+				(*table)[r][i] = patterns->get(r, i);
+			}
+		}
+
+		rows = table;
+		slots[p_num_inputs] = rows;
+	}
+
+	return rows;
+}
+
+/**
+ * @brief Checks whether the input columns for n inputs have already been built.
+ */
+inline bool InputPatternCache::is_cached(int p_num_inputs) {
+	return std::atomic_load(&entry(p_num_inputs).patterns) != nullptr;
+}
+
+/**
+ * @brief Returns the number of bytes of all cached input columns.
+ */
+inline uint64_t InputPatternCache::memory_usage() {
+
+	uint64_t usage = 0;
+
+	for (int n = 0; n <= MAX_INPUTS; n++) {
+		std::shared_ptr<const InputPatterns> patterns = std::atomic_load(
+				&entry(n).patterns);
+
+		if (patterns) {
+			usage += patterns->memory_usage();
+		}
+	}
+
+	return usage;
+}
+
+#endif /* INPUTPATTERNCACHE_H_ */
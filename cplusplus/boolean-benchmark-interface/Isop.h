@@ -0,0 +1,304 @@
+#ifndef ISOP_H_
+#define ISOP_H_
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Cover.h"
+#include "OutputColumn.h"
+#include "TruthTable.h"
+#include "ParallelFor.h"
+
+/*
+ * @brief Extracts irredundant sum-of-products covers from packed truth tables.
+ *
+ * @details Implements the recursive ISOP algorithm of Minato and Morreale. For a lower
+ * bound L (the ON-set) and an upper bound U (the ON-set and the don't cares), the
+ * function is split on its top variable x:
+ *
+ * 		C0 = isop(L0 & ~U1, U0)        cubes which need x = 0
+ * 		C1 = isop(L1 & ~U0, U1)        cubes which need x = 1
+ * 		Cs = isop(L0 & ~R0 | L1 & ~R1, U0 & U1)
+ *
+ * where R0 and R1 are the functions covered by C0 and C1. The result is
+ * x' C0 + x C1 + Cs, in which no cube can be removed or enlarged.
+ *
+ * The top variable of a subspace is its most significant row bit, so the cofactors
+ * are the lower and upper half of the packed words. Subspaces of at most 6 variables
+ * are processed within a single word.
+ *
+ * The outputs are extracted in parallel and identical cubes of different outputs
+ * are merged into one multi-output cube.
+ */
+class Isop {
+private:
+	struct Term {
+		uint64_t value;
+		uint64_t care;
+	};
+
+	static uint64_t low_mask(int p_num_vars);
+
+	static uint64_t isop_word(uint64_t p_lower, uint64_t p_upper, int p_num_vars,
+			uint64_t p_value, uint64_t p_care, std::vector<Term> &p_terms);
+	static void isop_words(const uint64_t *p_lower, const uint64_t *p_upper,
+			int p_num_vars, uint64_t p_value, uint64_t p_care,
+			std::vector<Term> &p_terms, uint64_t *p_result);
+
+public:
+	static std::vector<Cube> extract_output(const OutputColumn &p_column,
+			const OutputColumn *p_care, int p_output, int p_num_outputs);
+
+	template<class T>
+	static Cover extract(const TruthTable<T> &p_table, int p_num_threads = 0);
+};
+
+/**
+ * @brief Returns the mask of the rows of a subspace with up to 6 variables.
+ */
+inline uint64_t Isop::low_mask(int p_num_vars) {
+	return (p_num_vars >= 6) ?
+			~uint64_t(0) : (uint64_t(1) << (uint64_t(1) << p_num_vars)) - 1;
+}
+
+/**
+ * @brief ISOP of a subspace with up to 6 variables, stored in the low bits of a word.
+ *
+ * @return Function which is covered by the appended terms
+ */
+inline uint64_t Isop::isop_word(uint64_t p_lower, uint64_t p_upper,
+		int p_num_vars, uint64_t p_value, uint64_t p_care,
+		std::vector<Term> &p_terms) {
+
+	uint64_t full = low_mask(p_num_vars);
+
+	if ((p_lower & full) == 0) {
+		return 0;
+	}
+
+	if ((p_upper & full) == full) {
+		p_terms.push_back( { p_value, p_care });
+		return full;
+	}
+
+	int v = p_num_vars - 1;
+	int half = 1 << v;
+	uint64_t mask = low_mask(v);
+	uint64_t bit = uint64_t(1) << v;
+
+	uint64_t l0 = p_lower & mask;
+	uint64_t l1 = (p_lower >> half) & mask;
+	uint64_t u0 = p_upper & mask;
+	uint64_t u1 = (p_upper >> half) & mask;
+
+	uint64_t r0 = isop_word(l0 & ~u1, u0, v, p_value, p_care | bit, p_terms);
+	uint64_t r1 = isop_word(l1 & ~u0, u1, v, p_value | bit, p_care | bit, p_terms);
+	uint64_t rs = isop_word((l0 & ~r0) | (l1 & ~r1), u0 & u1, v, p_value, p_care,
+			p_terms);
+
+	return (r0 | rs) | ((r1 | rs) << half);
+}
+
+/**
+ * @brief ISOP of a subspace with more than 6 variables.
+ *
+ * @param p_lower Lower bound with 2^(p_num_vars - 6) words
+ * @param p_upper Upper bound with 2^(p_num_vars - 6) words
+ * @param p_value Values of the row bits which are fixed by the recursion
+ * @param p_care Row bits which are fixed by the recursion
+ * @param p_result Function which is covered by the appended terms
+ */
+inline void Isop::isop_words(const uint64_t *p_lower, const uint64_t *p_upper,
+		int p_num_vars, uint64_t p_value, uint64_t p_care,
+		std::vector<Term> &p_terms, uint64_t *p_result) {
+
+	if (p_num_vars <= 6) {
+		*p_result = isop_word(*p_lower, *p_upper, p_num_vars, p_value, p_care,
+				p_terms);
+		return;
+	}
+
+	uint64_t num_words = uint64_t(1) << (p_num_vars - 6);
+
+	bool lower_zero = std::all_of(p_lower, p_lower + num_words,
+			[](uint64_t w) { return w == 0; });
+
+	if (lower_zero) {
+		std::fill(p_result, p_result + num_words, 0);
+		return;
+	}
+
+	bool upper_full = std::all_of(p_upper, p_upper + num_words,
+			[](uint64_t w) { return w == ~uint64_t(0); });
+
+	if (upper_full) {
+		p_terms.push_back( { p_value, p_care });
+		std::fill(p_result, p_result + num_words, ~uint64_t(0));
+		return;
+	}
+
+	int v = p_num_vars - 1;
+	uint64_t half = num_words / 2;
+	uint64_t bit = uint64_t(1) << v;
+
+	const uint64_t *l0 = p_lower;
+	const uint64_t *l1 = p_lower + half;
+	const uint64_t *u0 = p_upper;
+	const uint64_t *u1 = p_upper + half;
+
+	std::vector<uint64_t> buffer(4 * half);
+	uint64_t *lower = buffer.data();
+	uint64_t *upper = lower + half;
+	uint64_t *r0 = upper + half;
+	uint64_t *r1 = r0 + half;
+
+	for (uint64_t w = 0; w < half; w++) {
+		lower[w] = l0[w] & ~u1[w];
+	}
+
+	isop_words(lower, u0, v, p_value, p_care | bit, p_terms, r0);
+
+	for (uint64_t w = 0; w < half; w++) {
+		lower[w] = l1[w] & ~u0[w];
+	}
+
+	isop_words(lower, u1, v, p_value | bit, p_care | bit, p_terms, r1);
+
+	for (uint64_t w = 0; w < half; w++) {
+		lower[w] = (l0[w] & ~r0[w]) | (l1[w] & ~r1[w]);
+		upper[w] = u0[w] & u1[w];
+	}
+
+	// The shared part is written behind the result of x = 0
+	uint64_t *rs = p_result + half;
+
+	isop_words(lower, upper, v, p_value, p_care, p_terms, rs);
+
+	for (uint64_t w = 0; w < half; w++) {
+		p_result[w] = r0[w] | rs[w];
+		p_result[half + w] = r1[w] | rs[w];
+	}
+}
+
+/**
+ * @brief Extracts the ISOP of a single output.
+ *
+ * @param p_column Output column, its rows are the ON-set
+ * @param p_care Care mask of the output, or nullptr if it is completely specified
+ * @param p_output Index of the output in the cubes
+ * @param p_num_outputs Number of outputs of the cubes
+ */
+inline std::vector<Cube> Isop::extract_output(const OutputColumn &p_column,
+		const OutputColumn *p_care, int p_output, int p_num_outputs) {
+
+	uint64_t num_rows = p_column.rows();
+
+	if (num_rows == 0 || (num_rows & (num_rows - 1)) != 0 || num_rows > (uint64_t(1) << 40)) {
+		throw std::runtime_error("Number of rows is out of range!");
+	}
+
+	int num_inputs = __builtin_ctzll(num_rows);
+	uint64_t num_words = OutputColumn::num_words(num_rows);
+
+	WordVector lower;
+	WordVector upper;
+
+	p_column.to_words(lower);
+
+	if (p_care != nullptr) {
+		p_care->to_words(upper);
+
+		for (uint64_t w = 0; w < num_words; w++) {
+			lower[w] &= upper[w];
+			upper[w] = lower[w] | ~upper[w];
+		}
+	} else {
+		upper = lower;
+	}
+
+	std::vector<Term> terms;
+	std::vector<uint64_t> result(num_words);
+
+	isop_words(lower.data(), upper.data(), num_inputs, 0, 0, terms, result.data());
+
+	std::vector<Cube> cubes(terms.size());
+
+	for (size_t k = 0; k < terms.size(); k++) {
+		cubes[k].value = terms[k].value;
+		cubes[k].care = terms[k].care;
+		cubes[k].outputs.assign(LineDecoder::num_words(p_num_outputs), 0);
+		cubes[k].outputs[p_output >> 6] |= uint64_t(1) << (p_output & 63);
+	}
+
+	return cubes;
+}
+
+/**
+ * @brief Extracts a multi-output cover of a table.
+ *
+ * @details Every output is covered by its own irredundant cubes. Cubes which occur in
+ * several outputs are written once with all of these outputs. Don't care rows of
+ * the table are used to enlarge the cubes.
+ *
+ * @param p_table Truth table with packed output columns
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+template<class T>
+Cover Isop::extract(const TruthTable<T> &p_table, int p_num_threads) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+	const std::vector<OutputColumn> &care_columns = p_table.get_care_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	int num_inputs = __builtin_ctzll(columns.at(0).rows());
+	int num_outputs = columns.size();
+
+	std::vector<std::vector<Cube>> output_cubes(num_outputs);
+
+	parallel_for(num_outputs, p_num_threads, [&](uint64_t p_output, int) {
+		output_cubes[p_output] = extract_output(columns[p_output],
+				care_columns.empty() ? nullptr : &care_columns[p_output], p_output,
+				num_outputs);
+	});
+
+	// Merge the cubes of all outputs by their input part
+	Cover cover(num_inputs, num_outputs);
+	std::vector<Cube> merged;
+	std::unordered_map<uint64_t, std::vector<size_t>> index;
+
+	for (int j = 0; j < num_outputs; j++) {
+		for (Cube &cube : output_cubes[j]) {
+			uint64_t key = cube.value * 0x9E3779B97F4A7C15ULL ^ cube.care;
+			std::vector<size_t> &candidates = index[key];
+
+			auto it = std::find_if(candidates.begin(), candidates.end(),
+					[&](size_t k) {
+						return merged[k].value == cube.value
+								&& merged[k].care == cube.care;
+					});
+
+			if (it != candidates.end()) {
+				merged[*it].outputs[j >> 6] |= uint64_t(1) << (j & 63);
+			} else {
+				candidates.push_back(merged.size());
+				merged.push_back(std::move(cube));
+			}
+		}
+
+		std::vector<Cube>().swap(output_cubes[j]);
+	}
+
+	for (const Cube &cube : merged) {
+		cover.add_cube(cube);
+	}
+
+	return cover;
+}
+
+#endif /* ISOP_H_ */
@@ -0,0 +1,214 @@
+#ifndef LINEDECODER_H_
+#define LINEDECODER_H_
+
+#include <cstdint>
+#include <algorithm>
+#include <string>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+/*
+ * @brief Decodes the '0'/'1'/'-' characters of a TT or PLA body row into bitmasks.
+ *
+ * @details Bit j of the value mask is set for a '1' at column j, bit j of the care
+ * mask is set for a '0' or '1'. The characters are classified 64, 32 or 16 at a time
+ * with AVX-512BW, AVX2 or SSE2 compares and movemasks, depending on the instruction
+ * set the file is compiled for. The remaining characters are decoded by a scalar loop.
+ *
+ * No exception is thrown while decoding. Instead, the column of the first invalid
+ * character is returned, so that the caller can report the position of the error.
+ */
+class LineDecoder {
+public:
+	static int decode(const char *p_chars, int p_length, uint64_t *p_value,
+			uint64_t *p_care);
+	static int find_clear(const uint64_t *p_mask, int p_length);
+	static uint64_t to_row_order(uint64_t p_mask, int p_length);
+	static int num_words(int p_length);
+	static bool is_body_line(const std::string &p_line);
+};
+
+/**
+ * @brief Decodes a sequence of characters into a value and a care mask.
+ *
+ * @param p_chars Pointer to the first character
+ * @param p_length Number of characters to decode
+ * @param p_value Value mask with num_words(p_length) words
+ * @param p_care Care mask with num_words(p_length) words
+ *
+ * @return -1 on success, otherwise the zero-based column of the first
+ * invalid character
+ */
+inline int LineDecoder::decode(const char *p_chars, int p_length,
+		uint64_t *p_value, uint64_t *p_care) {
+
+	int n_words = num_words(p_length);
+	int j = 0;
+
+	std::fill(p_value, p_value + n_words, 0);
+	std::fill(p_care, p_care + n_words, 0);
+
+#if defined(__AVX512BW__)
+	const __m512i zero_512 = _mm512_set1_epi8('0');
+	const __m512i one_512 = _mm512_set1_epi8('1');
+	const __m512i dash_512 = _mm512_set1_epi8('-');
+
+	for (; j + 64 <= p_length; j += 64) {
+		__m512i v = _mm512_loadu_si512((const void*) (p_chars + j));
+
+		uint64_t ones = _mm512_cmpeq_epi8_mask(v, one_512);
+		uint64_t zeros = _mm512_cmpeq_epi8_mask(v, zero_512);
+		uint64_t dashes = _mm512_cmpeq_epi8_mask(v, dash_512);
+		uint64_t valid = ones | zeros | dashes;
+
+		if (valid != ~uint64_t(0)) {
+			return j + __builtin_ctzll(~valid);
+		}
+
+		p_value[j >> 6] = ones;
+		p_care[j >> 6] = ones | zeros;
+	}
+#endif
+
+#if defined(__AVX2__)
+	const __m256i zero_256 = _mm256_set1_epi8('0');
+	const __m256i one_256 = _mm256_set1_epi8('1');
+	const __m256i dash_256 = _mm256_set1_epi8('-');
+
+	for (; j + 32 <= p_length; j += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i*) (p_chars + j));
+
+		uint64_t ones = (uint32_t) _mm256_movemask_epi8(
+				_mm256_cmpeq_epi8(v, one_256));
+		uint64_t zeros = (uint32_t) _mm256_movemask_epi8(
+				_mm256_cmpeq_epi8(v, zero_256));
+		uint64_t dashes = (uint32_t) _mm256_movemask_epi8(
+				_mm256_cmpeq_epi8(v, dash_256));
+		uint64_t valid = ones | zeros | dashes;
+
+		if (valid != 0xFFFFFFFFu) {
+			return j + __builtin_ctzll(~valid);
+		}
+
+		p_value[j >> 6] |= ones << (j & 63);
+		p_care[j >> 6] |= (ones | zeros) << (j & 63);
+	}
+#endif
+
+#if defined(__SSE2__)
+	const __m128i zero_128 = _mm_set1_epi8('0');
+	const __m128i one_128 = _mm_set1_epi8('1');
+	const __m128i dash_128 = _mm_set1_epi8('-');
+
+	for (; j + 16 <= p_length; j += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*) (p_chars + j));
+
+		uint64_t ones = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, one_128));
+		uint64_t zeros = (uint32_t) _mm_movemask_epi8(
+				_mm_cmpeq_epi8(v, zero_128));
+		uint64_t dashes = (uint32_t) _mm_movemask_epi8(
+				_mm_cmpeq_epi8(v, dash_128));
+		uint64_t valid = ones | zeros | dashes;
+
+		if (valid != 0xFFFFu) {
+			return j + __builtin_ctzll(~valid);
+		}
+
+		p_value[j >> 6] |= ones << (j & 63);
+		p_care[j >> 6] |= (ones | zeros) << (j & 63);
+	}
+#endif
+
+	// Scalar fallback for the remaining characters
+	for (; j < p_length; j++) {
+		char c = p_chars[j];
+		uint64_t bit = uint64_t(1) << (j & 63);
+
+		if (c == '1') {
+			p_value[j >> 6] |= bit;
+			p_care[j >> 6] |= bit;
+		} else if (c == '0') {
+			p_care[j >> 6] |= bit;
+		} else if (c != '-') {
+			return j;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Returns the first column whose bit is not set in the given mask.
+ *
+ * @details Used to reject don't care characters where only '0' and '1' are valid.
+ *
+ * @return -1 if all bits are set, otherwise the zero-based column
+ */
+inline int LineDecoder::find_clear(const uint64_t *p_mask, int p_length) {
+
+	for (int i = 0; i < num_words(p_length); i++) {
+		uint64_t expected = ~uint64_t(0);
+
+		if (i == p_length / 64) {
+			expected = (uint64_t(1) << (p_length & 63)) - 1;
+		}
+
+		uint64_t missing = ~p_mask[i] & expected;
+
+		if (missing != 0) {
+			return i * 64 + __builtin_ctzll(missing);
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Converts a mask in column order into row index order.
+ *
+ * @details The first input is the most significant bit of the row index.
+ * Therefore, bit j of a decoded mask corresponds to bit (p_length - 1 - j)
+ * of the row index.
+ *
+ * @param p_mask Decoded mask of at most 64 columns
+ * @param p_length Number of columns
+ */
+inline uint64_t LineDecoder::to_row_order(uint64_t p_mask, int p_length) {
+
+	if (p_length == 0) {
+		return 0;
+	}
+
+	// Reverse the bits of the word
+	p_mask = ((p_mask >> 1) & 0x5555555555555555ULL)
+			| ((p_mask & 0x5555555555555555ULL) << 1);
+	p_mask = ((p_mask >> 2) & 0x3333333333333333ULL)
+			| ((p_mask & 0x3333333333333333ULL) << 2);
+	p_mask = ((p_mask >> 4) & 0x0F0F0F0F0F0F0F0FULL)
+			| ((p_mask & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	p_mask = __builtin_bswap64(p_mask);
+
+	return p_mask >> (64 - p_length);
+}
+
+/**
+ * @brief Returns the number of 64 bit words of a mask for the given number of columns.
+ */
+inline int LineDecoder::num_words(int p_length) {
+	return (p_length + 63) / 64;
+}
+
+/**
+ * @brief Checks whether a line belongs to the body of a benchmark file.
+ *
+ * @details Header lines start with a keyword, body rows with a '0', '1' or '-'.
+ * The header scans stop at the first body row instead of reading the whole file.
+ */
+inline bool LineDecoder::is_body_line(const std::string &p_line) {
+	return p_line.size() > 0
+			&& (p_line[0] == '0' || p_line[0] == '1' || p_line[0] == '-');
+}
+
+#endif /* LINEDECODER_H_ */
@@ -4,70 +4,65 @@
 #ifndef MINTERM_H_
 #define MINTERM_H_
 
-#include <vector>
+#include <string>
+#include <cstdint>
 
 class Minterm {
 private:
-	std::vector<char> *term;
 	int output_index;
-	int num_inputs;
+	uint64_t value_mask;
+	uint64_t care_mask;
+	std::string outputs;
 public:
-	Minterm(int p_num_inputs, int p_output_index);
-	virtual ~Minterm();
-	void set_term(const std::vector<char> *p_term);
+	Minterm(int p_output_index);
+	void set_masks(uint64_t p_value_mask, uint64_t p_care_mask);
+	void set_outputs(const std::string &p_outputs);
 	int get_output_index() const;
-	bool match(const std::vector<char> *p_term);
+	uint64_t get_value_mask() const;
+	uint64_t get_care_mask() const;
+	const std::string& get_outputs() const;
 };
 
-Minterm::Minterm(int p_num_inputs, int p_output_index) {
-	this->num_inputs = p_num_inputs;
+inline Minterm::Minterm(int p_output_index) {
 	this->output_index = p_output_index;
-	this->term = new std::vector<char>(this->num_inputs);
+	this->value_mask = 0;
+	this->care_mask = 0;
 }
 
-Minterm::~Minterm() {
-	delete this->term;
+/**
+ * @brief Sets the term as bitmasks in row index order.
+ *
+ * @details Bit k of the masks corresponds to bit k of the row index. The care mask
+ * has a bit set for every '0' and '1' of the term, the value mask for every '1'.
+ *
+ * @see LineDecoder
+ */
+inline void Minterm::set_masks(uint64_t p_value_mask, uint64_t p_care_mask) {
+	this->value_mask = p_value_mask;
+	this->care_mask = p_care_mask;
 }
 
-void Minterm::set_term(const std::vector<char> *p_term) {
-	for (int i = 0; i < this->num_inputs; i++) {
-		this->term->at(i) = p_term->at(i);
-	}
+/**
+ * @brief Sets the output part of the term, one of '0', '1', '-' and '~' per output.
+ */
+inline void Minterm::set_outputs(const std::string &p_outputs) {
+	this->outputs = p_outputs;
 }
 
-int Minterm::get_output_index() const {
-	return this->output_index;
+inline uint64_t Minterm::get_value_mask() const {
+	return this->value_mask;
 }
 
-bool Minterm::match(const std::vector<char> *p_term) {
-	bool state = true;
-	for (int i = 0; i < this->num_inputs; i++) {
-		if (this->term->at(i) != '-') {
-			if (this->term->at(i) != p_term->at(i)) {
-				state = false;
-			}
-		}
-	}
-
-	if (state == true) {
-		for (int i = 0; i < this->num_inputs; i++) {
-			std::cout << this->term->at(i);
-		}
-
-		std::cout << "   ";
-
-		for (int i = 0; i < this->num_inputs; i++) {
-			std::cout << p_term->at(i);
-		}
-
-		std::cout << "   " << this->output_index;
-
-		std::cout<< std::endl;
-	} else {
+inline uint64_t Minterm::get_care_mask() const {
+	return this->care_mask;
+}
 
-	}
+inline const std::string& Minterm::get_outputs() const {
+	return this->outputs;
+}
 
-	return state;
+inline int Minterm::get_output_index() const {
+	return this->output_index;
 }
 
 #endif /* MINTERM_H_ */
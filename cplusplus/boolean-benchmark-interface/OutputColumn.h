@@ -0,0 +1,493 @@
+#ifndef OUTPUTCOLUMN_H_
+#define OUTPUTCOLUMN_H_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+#include "TableAllocator.h"
+
+/*
+ * Storage type for bit-packed table data. Bit r of a dense column is stored
+ * in bit (r % 64) of word (r / 64). The memory is allocated according to the
+ * allocation policy of the vector, see TableAllocator.
+ */
+typedef std::vector<uint64_t, TableAllocator<uint64_t>> WordVector;
+
+/*
+ * @brief Stores one output column of a truth table in a density-adaptive representation.
+ *
+ * @details The representation is chosen from the density of the ON-set when the
+ * column is packed:
+ *
+ * 		DENSE  : One bit per row, 64 rows per word.
+ * 		SPARSE : Sorted row indices of the ON-set.
+ * 		RLE    : Sorted [begin, end) row ranges of the ON-set, stored pairwise.
+ *
+ * A compressed representation is only chosen when it needs at most half the
+ * memory of the dense one, since random access to it is logarithmic instead of
+ * constant. All representations share one word vector, which keeps the raw buffer
+ * accessible in a uniform way.
+ */
+class OutputColumn {
+public:
+	enum Representation {
+		DENSE = 0, SPARSE = 1, RLE = 2
+	};
+
+private:
+	Representation representation = DENSE;
+
+	uint64_t num_rows = 0;
+	uint64_t num_ones = 0;
+
+	WordVector data;
+
+	uint64_t find_run(uint64_t p_row) const;
+
+public:
+	OutputColumn() = default;
+	OutputColumn(const WordVector &p_words, uint64_t p_num_rows,
+			const AllocationPolicy &p_policy = TableMemory::default_policy());
+	OutputColumn(const WordVector &p_words, uint64_t p_num_rows,
+			Representation p_representation,
+			const AllocationPolicy &p_policy = TableMemory::default_policy());
+	virtual ~OutputColumn() = default;
+
+	static uint64_t num_words(uint64_t p_num_rows);
+	static uint64_t count_differences(const uint64_t *p_a, const uint64_t *p_b,
+			const uint64_t *p_mask, uint64_t p_count,
+			uint64_t p_tail = ~uint64_t(0));
+
+	bool get(uint64_t p_row) const;
+
+	uint64_t count_ones() const;
+	uint64_t count_ones(uint64_t p_begin, uint64_t p_end) const;
+
+	template<class F>
+	void for_each_one(F p_func) const;
+
+	void to_words(WordVector &p_words) const;
+	void copy_words(uint64_t p_word_begin, uint64_t p_word_count,
+			uint64_t *p_dst) const;
+
+	Representation get_representation() const;
+	const WordVector& get_data() const;
+	uint64_t rows() const;
+	size_t memory_usage() const;
+};
+
+/**
+ * @brief Packs a dense bit vector and chooses the representation by density.
+ *
+ * @details Counts the ON-set rows and the number of runs in one pass over the words
+ * and compares the memory footprint of the three representations.
+ *
+ * @param p_words Dense bit vector with at least num_words(p_num_rows) words
+ * @param p_num_rows Number of rows of the column
+ * @param p_policy Allocation policy of the column data
+ */
+inline OutputColumn::OutputColumn(const WordVector &p_words,
+		uint64_t p_num_rows, const AllocationPolicy &p_policy) {
+
+	uint64_t n_words = num_words(p_num_rows);
+	uint64_t ones = 0;
+	uint64_t runs = 0;
+	uint64_t carry = 0;
+
+	if (p_words.size() < n_words) {
+		throw std::runtime_error("Column data is smaller than the number of rows!");
+	}
+
+	for (uint64_t i = 0; i < n_words; i++) {
+		uint64_t w = p_words[i];
+
+		// Mask the unused bits of the last word
+		if (i == n_words - 1 && (p_num_rows & 63) != 0) {
+			w &= (uint64_t(1) << (p_num_rows & 63)) - 1;
+		}
+
+		ones += __builtin_popcountll(w);
+
+		// A run starts at every set bit whose predecessor is not set
+		runs += __builtin_popcountll(w & ~((w << 1) | carry));
+		carry = w >> 63;
+	}
+
+	Representation choice = DENSE;
+
+	if (ones <= n_words / 2 && ones <= 2 * runs) {
+		choice = SPARSE;
+	} else if (2 * runs <= n_words / 2) {
+		choice = RLE;
+	}
+
+	*this = OutputColumn(p_words, p_num_rows, choice, p_policy);
+}
+
+/**
+ * @brief Packs a dense bit vector into the given representation.
+ *
+ * @param p_words Dense bit vector with at least num_words(p_num_rows) words
+ * @param p_num_rows Number of rows of the column
+ * @param p_representation Representation which is used for the column
+ * @param p_policy Allocation policy of the column data
+ */
+inline OutputColumn::OutputColumn(const WordVector &p_words,
+		uint64_t p_num_rows, Representation p_representation,
+		const AllocationPolicy &p_policy) : data(p_policy) {
+
+	uint64_t n_words = num_words(p_num_rows);
+
+	if (p_words.size() < n_words) {
+		throw std::runtime_error("Column data is smaller than the number of rows!");
+	}
+
+	this->representation = p_representation;
+	this->num_rows = p_num_rows;
+	this->num_ones = 0;
+
+	if (p_representation == DENSE) {
+		this->data.assign(p_words.begin(), p_words.begin() + n_words);
+
+		if (n_words > 0 && (p_num_rows & 63) != 0) {
+			this->data.back() &= (uint64_t(1) << (p_num_rows & 63)) - 1;
+		}
+
+		for (uint64_t w : this->data) {
+			this->num_ones += __builtin_popcountll(w);
+		}
+		return;
+	}
+
+	bool in_run = false;
+
+	for (uint64_t i = 0; i < n_words; i++) {
+		uint64_t w = p_words[i];
+
+		if (i == n_words - 1 && (p_num_rows & 63) != 0) {
+			w &= (uint64_t(1) << (p_num_rows & 63)) - 1;
+		}
+
+		this->num_ones += __builtin_popcountll(w);
+
+		if (p_representation == SPARSE) {
+			while (w != 0) {
+				this->data.push_back(i * 64 + __builtin_ctzll(w));
+				w &= w - 1;
+			}
+		} else if ((w == 0 && !in_run) || (w == ~uint64_t(0) && in_run)) {
+			// Fast path for words without a change of the bit value
+			continue;
+		} else {
+			// Record the positions where the bit value changes
+			for (uint64_t b = 0; b < 64; b++) {
+				bool bit = (w >> b) & 1;
+				if (bit != in_run) {
+					this->data.push_back(i * 64 + b);
+					in_run = bit;
+				}
+			}
+		}
+	}
+
+	if (p_representation == RLE && in_run) {
+		this->data.push_back(p_num_rows);
+	}
+
+	this->data.shrink_to_fit();
+}
+
+/**
+ * @brief Returns the number of 64 bit words needed to store the given number of rows.
+ */
+inline uint64_t OutputColumn::num_words(uint64_t p_num_rows) {
+	return (p_num_rows + 63) / 64;
+}
+
+/**
+ * @brief Counts the bits in which two blocks of dense words differ.
+ *
+ * @details This is the error counting kernel of all evaluators. Bits which are
+ * cleared in the mask are skipped, e.g. don't care rows, and the tail mask is
+ * applied to the last word, e.g. to skip the unused bits after the last row.
+ *
+ * @param p_a First block
+ * @param p_b Second block
+ * @param p_mask Mask of the compared bits, nullptr to compare all bits
+ * @param p_count Number of words of the blocks
+ * @param p_tail Mask of the compared bits of the last word
+ */
+inline uint64_t OutputColumn::count_differences(const uint64_t *p_a,
+		const uint64_t *p_b, const uint64_t *p_mask, uint64_t p_count,
+		uint64_t p_tail) {
+
+	if (p_count == 0) {
+		return 0;
+	}
+
+	uint64_t last = p_count - 1;
+	uint64_t errors = 0;
+
+	if (p_mask != nullptr) {
+		for (uint64_t w = 0; w < last; w++) {
+			errors += __builtin_popcountll((p_a[w] ^ p_b[w]) & p_mask[w]);
+		}
+
+		p_tail &= p_mask[last];
+	} else {
+		for (uint64_t w = 0; w < last; w++) {
+			errors += __builtin_popcountll(p_a[w] ^ p_b[w]);
+		}
+	}
+
+	return errors + __builtin_popcountll((p_a[last] ^ p_b[last]) & p_tail);
+}
+
+/**
+ * @brief Returns the index of the last run which begins at or before the given row.
+ *
+ * @return Index of the run or data.size() if no run begins before the row.
+ */
+inline uint64_t OutputColumn::find_run(uint64_t p_row) const {
+
+	uint64_t lo = 0;
+	uint64_t hi = this->data.size() / 2;
+
+	// Binary search over the begin positions of the runs
+	while (lo < hi) {
+		uint64_t mid = (lo + hi) / 2;
+		if (this->data[2 * mid] <= p_row) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return (lo == 0) ? this->data.size() : lo - 1;
+}
+
+/**
+ * @brief Returns the value of the column at the given row.
+ *
+ * @param p_row Row index, 0 <= p_row < rows()
+ */
+inline bool OutputColumn::get(uint64_t p_row) const {
+
+	assert(p_row < this->num_rows);
+
+	switch (this->representation) {
+	case DENSE:
+		return (this->data[p_row >> 6] >> (p_row & 63)) & 1;
+	case SPARSE:
+		return std::binary_search(this->data.begin(), this->data.end(), p_row);
+	case RLE: {
+		uint64_t run = this->find_run(p_row);
+		return run != this->data.size() && p_row < this->data[2 * run + 1];
+	}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Returns the number of rows of the ON-set.
+ */
+inline uint64_t OutputColumn::count_ones() const {
+	return this->num_ones;
+}
+
+/**
+ * @brief Returns the number of ON-set rows within the range [p_begin, p_end).
+ */
+inline uint64_t OutputColumn::count_ones(uint64_t p_begin,
+		uint64_t p_end) const {
+
+	p_end = std::min(p_end, this->num_rows);
+
+	if (p_begin >= p_end) {
+		return 0;
+	}
+
+	uint64_t count = 0;
+
+	switch (this->representation) {
+	case DENSE: {
+		uint64_t first = p_begin >> 6;
+		uint64_t last = (p_end - 1) >> 6;
+
+		for (uint64_t i = first; i <= last; i++) {
+			uint64_t w = this->data[i];
+			if (i == first) {
+				w &= ~uint64_t(0) << (p_begin & 63);
+			}
+			if (i == last && (p_end & 63) != 0) {
+				w &= (uint64_t(1) << (p_end & 63)) - 1;
+			}
+			count += __builtin_popcountll(w);
+		}
+		break;
+	}
+	case SPARSE:
+		count = std::lower_bound(this->data.begin(), this->data.end(), p_end)
+				- std::lower_bound(this->data.begin(), this->data.end(),
+						p_begin);
+		break;
+	case RLE:
+		for (uint64_t i = 0; i < this->data.size(); i += 2) {
+			uint64_t b = std::max(this->data[i], p_begin);
+			uint64_t e = std::min(this->data[i + 1], p_end);
+			if (b < e) {
+				count += e - b;
+			}
+		}
+		break;
+	}
+
+	return count;
+}
+
+/**
+ * @brief Calls the given function for every row of the ON-set in ascending order.
+ *
+ * @tparam F Callable with the signature void(uint64_t row)
+ */
+template<class F>
+void OutputColumn::for_each_one(F p_func) const {
+
+	switch (this->representation) {
+	case DENSE:
+		for (uint64_t i = 0; i < this->data.size(); i++) {
+			uint64_t w = this->data[i];
+			while (w != 0) {
+				p_func(i * 64 + __builtin_ctzll(w));
+				w &= w - 1;
+			}
+		}
+		break;
+	case SPARSE:
+		for (uint64_t row : this->data) {
+			p_func(row);
+		}
+		break;
+	case RLE:
+		for (uint64_t i = 0; i < this->data.size(); i += 2) {
+			for (uint64_t row = this->data[i]; row < this->data[i + 1]; row++) {
+				p_func(row);
+			}
+		}
+		break;
+	}
+}
+
+/**
+ * @brief Materializes the column as a dense bit vector.
+ *
+ * @param p_words Target vector, resized to num_words(rows())
+ */
+inline void OutputColumn::to_words(WordVector &p_words) const {
+	p_words.assign(num_words(this->num_rows), 0);
+	this->copy_words(0, p_words.size(), p_words.data());
+}
+
+/**
+ * @brief Decodes a block of dense words of the column.
+ *
+ * @details Allows block-wise consumers to scan compressed columns without
+ * materializing them completely.
+ *
+ * @param p_word_begin Index of the first word of the block
+ * @param p_word_count Number of words of the block
+ * @param p_dst Destination buffer for p_word_count words
+ */
+inline void OutputColumn::copy_words(uint64_t p_word_begin,
+		uint64_t p_word_count, uint64_t *p_dst) const {
+
+	uint64_t row_begin = p_word_begin * 64;
+	uint64_t row_end = std::min((p_word_begin + p_word_count) * 64,
+			this->num_rows);
+
+	std::fill(p_dst, p_dst + p_word_count, 0);
+
+	if (row_begin >= row_end) {
+		return;
+	}
+
+	switch (this->representation) {
+	case DENSE:
+		std::copy(this->data.begin() + p_word_begin,
+				this->data.begin()
+						+ std::min<uint64_t>(p_word_begin + p_word_count,
+								this->data.size()), p_dst);
+		break;
+	case SPARSE: {
+		auto it = std::lower_bound(this->data.begin(), this->data.end(),
+				row_begin);
+		for (; it != this->data.end() && *it < row_end; ++it) {
+			uint64_t r = *it - row_begin;
+			p_dst[r >> 6] |= uint64_t(1) << (r & 63);
+		}
+		break;
+	}
+	case RLE: {
+		uint64_t run = this->find_run(row_begin);
+		run = (run == this->data.size()) ? 0 : run;
+
+		for (uint64_t i = 2 * run; i < this->data.size(); i += 2) {
+			uint64_t b = std::max(this->data[i], row_begin);
+			uint64_t e = std::min(this->data[i + 1], row_end);
+
+			if (this->data[i] >= row_end) {
+				break;
+			}
+
+			// Set the bits of the range [b, e) word by word
+			while (b < e) {
+				uint64_t r = b - row_begin;
+				uint64_t n = std::min<uint64_t>(64 - (r & 63), e - b);
+				uint64_t mask = (n == 64) ? ~uint64_t(0) :
+								((uint64_t(1) << n) - 1) << (r & 63);
+				p_dst[r >> 6] |= mask;
+				b += n;
+			}
+		}
+		break;
+	}
+	}
+}
+
+/**
+ * @brief Returns the representation which has been chosen for the column.
+ */
+inline OutputColumn::Representation OutputColumn::get_representation() const {
+	return this->representation;
+}
+
+/**
+ * @brief Returns the raw data of the column.
+ *
+ * @details Dense words, sorted row indices or pairwise run boundaries,
+ * depending on the representation.
+ */
+inline const WordVector& OutputColumn::get_data() const {
+	return this->data;
+}
+
+/**
+ * @brief Returns the number of rows of the column.
+ */
+inline uint64_t OutputColumn::rows() const {
+	return this->num_rows;
+}
+
+/**
+ * @brief Returns the number of bytes occupied by the column data.
+ */
+inline size_t OutputColumn::memory_usage() const {
+	return this->data.capacity() * sizeof(uint64_t);
+}
+
+#endif /* OUTPUTCOLUMN_H_ */
@@ -0,0 +1,89 @@
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Returns the number of workers which parallel_for() uses.
+ *
+ * @param p_count Number of indices
+ * @param p_num_threads Requested number of threads, 0 selects the hardware concurrency
+ *
+ * @return Number of workers between 1 and p_count, so callers can allocate the
+ * state of each worker in advance
+ */
+inline int parallel_workers(uint64_t p_count, int p_num_threads) {
+
+	if (p_num_threads <= 0) {
+		p_num_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	return std::max<uint64_t>(1, std::min<uint64_t>(p_num_threads, p_count));
+}
+
+/**
+ * @brief Calls a function for the indices 0 to p_count - 1 on parallel workers.
+ *
+ * @details The indices are handed out one by one in ascending order, so workers
+ * which finish early take over the remaining indices. The calling thread is worker
+ * 0 and the others are started for the call. If the function throws, no further
+ * indices are handed out and the first exception is rethrown after all workers
+ * have finished.
+ *
+ * @tparam F Callable with the signature void(uint64_t index, int worker), where
+ * worker is between 0 and parallel_workers(p_count, p_num_threads) - 1
+ *
+ * @param p_count Number of indices
+ * @param p_num_threads Number of threads, 0 selects the hardware concurrency
+ */
+template<class F>
+void parallel_for(uint64_t p_count, int p_num_threads, F p_func) {
+
+	int num_workers = parallel_workers(p_count, p_num_threads);
+
+	std::atomic<uint64_t> next(0);
+	std::exception_ptr error;
+	std::mutex error_mutex;
+
+	auto work = [&](int p_worker) {
+		uint64_t index;
+
+		while ((index = next.fetch_add(1)) < p_count) {
+			try {
+				p_func(index, p_worker);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+
+				if (!error) {
+					error = std::current_exception();
+				}
+
+				next.store(p_count);
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+
+	for (int t = 1; t < num_workers; t++) {
+		workers.emplace_back(work, t);
+	}
+
+	work(0);
+
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+#endif /* PARALLELFOR_H_ */
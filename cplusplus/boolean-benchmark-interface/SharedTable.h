@@ -0,0 +1,512 @@
+#ifndef SHAREDTABLE_H_
+#define SHAREDTABLE_H_
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <cassert>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "TruthTable.h"
+
+/*
+ * @brief Publishes a truth table into a named POSIX shared memory segment and attaches
+ * to it read-only from other processes.
+ *
+ * @details A publishing process writes the packed columns of a loaded table once, and
+ * every worker process maps the same physical pages instead of reading the benchmark
+ * file again. The segment only contains offsets relative to its start, so it can be
+ * mapped at any address:
+ *
+ * 		Header       : Magic, version, dimensions and the offsets of the sections.
+ * 		Columns      : One dense column per output with num_words words each.
+ * 		Care columns : One dense care mask per output, only for incompletely
+ * 		               specified functions.
+ * 		Names        : Model name, input names and output names, each stored as a
+ * 		               32 bit length followed by the characters.
+ *
+ * The columns are stored dense regardless of their representation in the table. This
+ * is intended: the segment is published once but evaluated by every worker, which then
+ * uses plain word access instead of decoding a sparse or RLE column per evaluation.
+ * The sections start at cache line boundaries.
+ *
+ * The name of a segment follows shm_open, e.g. "/add8". The segment persists until it
+ * is removed, existing mappings stay valid after the removal. On glibc before 2.34
+ * programs using this header have to be linked with -lrt.
+ */
+class SharedTable {
+private:
+	static const uint64_t MAGIC = 0x3130424154494242ULL; // "BBITAB01"
+	static const uint32_t VERSION = 1;
+	static const uint64_t ALIGNMENT = 64;
+
+	struct Header {
+		std::atomic<uint64_t> magic;
+		uint32_t version;
+		uint32_t has_care;
+		uint64_t num_inputs;
+		uint64_t num_outputs;
+		uint64_t num_rows;
+		uint64_t num_words;
+		uint64_t columns_offset;
+		uint64_t care_offset;
+		uint64_t names_offset;
+		uint64_t names_size;
+		uint64_t total_size;
+	};
+
+	const uint8_t *base = nullptr;
+	size_t mapped_size = 0;
+
+	const Header *header = nullptr;
+
+	std::string model_name;
+	std::vector<std::string> input_names;
+	std::vector<std::string> output_names;
+
+	static uint64_t align(uint64_t p_offset);
+
+	static void append_name(std::string &p_buffer, const std::string &p_name);
+	void read_names();
+
+public:
+	SharedTable() = default;
+	SharedTable(const std::string &p_name);
+	virtual ~SharedTable();
+
+	SharedTable(const SharedTable&) = delete;
+	SharedTable& operator=(const SharedTable&) = delete;
+
+	template<class T>
+	static void publish(const std::string &p_name, const TruthTable<T> &p_table);
+	static bool remove(const std::string &p_name);
+
+	void attach(const std::string &p_name);
+	void detach();
+	bool is_attached() const;
+
+	int inputs() const;
+	int outputs() const;
+	uint64_t rows() const;
+	uint64_t words() const;
+
+	const uint64_t* column(int p_output) const;
+	bool has_care_columns() const;
+	const uint64_t* care_column(int p_output) const;
+
+	bool get(uint64_t p_row, int p_output) const;
+	bool is_care(uint64_t p_row, int p_output) const;
+	uint64_t count_errors(int p_output, const uint64_t *p_words) const;
+
+	const std::string& get_model_name() const;
+	const std::vector<std::string>& get_input_names() const;
+	const std::vector<std::string>& get_output_names() const;
+
+	template<class T>
+	void load(TruthTable<T> &p_table) const;
+
+	size_t memory_usage() const;
+};
+
+/**
+ * @brief Attaches to a published table, see attach().
+ */
+inline SharedTable::SharedTable(const std::string &p_name) {
+	this->attach(p_name);
+}
+
+inline SharedTable::~SharedTable() {
+	this->detach();
+}
+
+inline uint64_t SharedTable::align(uint64_t p_offset) {
+	return (p_offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+inline void SharedTable::append_name(std::string &p_buffer,
+		const std::string &p_name) {
+
+	uint32_t length = p_name.size();
+	p_buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+	p_buffer += p_name;
+}
+
+/**
+ * @brief Writes the packed columns of a table into a new shared memory segment.
+ *
+ * @details An existing segment of the same name is removed first, processes which
+ * are attached to it keep their mapping. The magic number is written last, so a
+ * segment is never attached before it is complete.
+ *
+ * @param p_name Name of the segment, e.g. "/add8"
+ * @param p_table Table with packed output columns
+ */
+template<class T>
+void SharedTable::publish(const std::string &p_name,
+		const TruthTable<T> &p_table) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+	const std::vector<OutputColumn> &care_columns = p_table.get_care_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	uint64_t num_rows = columns.at(0).rows();
+
+	if (num_rows == 0 || (num_rows & (num_rows - 1)) != 0) {
+		throw std::runtime_error("Number of rows is not a power of two!");
+	}
+
+	std::string names;
+	append_name(names, p_table.get_model_name());
+
+	for (const std::string &name : p_table.get_input_names()) {
+		append_name(names, name);
+	}
+
+	for (const std::string &name : p_table.get_output_names()) {
+		append_name(names, name);
+	}
+
+	uint64_t num_words = OutputColumn::num_words(num_rows);
+	uint64_t column_bytes = columns.size() * num_words * sizeof(uint64_t);
+
+	Header layout;
+	layout.version = VERSION;
+	layout.has_care = care_columns.size() > 0;
+	layout.num_inputs = __builtin_ctzll(num_rows);
+	layout.num_outputs = columns.size();
+	layout.num_rows = num_rows;
+	layout.num_words = num_words;
+	layout.columns_offset = align(sizeof(Header));
+	layout.care_offset = align(layout.columns_offset + column_bytes);
+	layout.names_offset = align(layout.care_offset
+			+ (layout.has_care ? column_bytes : 0));
+	layout.names_size = names.size();
+	layout.total_size = layout.names_offset + layout.names_size;
+
+	shm_unlink(p_name.c_str());
+
+	int fd = shm_open(p_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+	if (fd < 0) {
+		throw std::runtime_error("Error creating shared memory segment!");
+	}
+
+	if (ftruncate(fd, layout.total_size) != 0) {
+		close(fd);
+		shm_unlink(p_name.c_str());
+		throw std::runtime_error("Error resizing shared memory segment!");
+	}
+
+	void *address = mmap(nullptr, layout.total_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (address == MAP_FAILED) {
+		shm_unlink(p_name.c_str());
+		throw std::runtime_error("Error mapping shared memory segment!");
+	}
+
+	uint8_t *segment = static_cast<uint8_t*>(address);
+	Header *header = reinterpret_cast<Header*>(segment);
+
+	header->magic.store(0, std::memory_order_relaxed);
+	header->version = layout.version;
+	header->has_care = layout.has_care;
+	header->num_inputs = layout.num_inputs;
+	header->num_outputs = layout.num_outputs;
+	header->num_rows = layout.num_rows;
+	header->num_words = layout.num_words;
+	header->columns_offset = layout.columns_offset;
+	header->care_offset = layout.care_offset;
+	header->names_offset = layout.names_offset;
+	header->names_size = layout.names_size;
+	header->total_size = layout.total_size;
+
+	uint64_t *words = reinterpret_cast<uint64_t*>(segment + layout.columns_offset);
+
+	for (size_t j = 0; j < columns.size(); j++) {
+		columns[j].copy_words(0, num_words, words + j * num_words);
+	}
+
+	if (layout.has_care) {
+		words = reinterpret_cast<uint64_t*>(segment + layout.care_offset);
+
+		for (size_t j = 0; j < care_columns.size(); j++) {
+			care_columns[j].copy_words(0, num_words, words + j * num_words);
+		}
+	}
+
+	std::memcpy(segment + layout.names_offset, names.data(), names.size());
+
+	header->magic.store(MAGIC, std::memory_order_release);
+	munmap(address, layout.total_size);
+}
+
+/**
+ * @brief Removes a published segment, returns false if it doesn't exist.
+ */
+inline bool SharedTable::remove(const std::string &p_name) {
+	return shm_unlink(p_name.c_str()) == 0;
+}
+
+/**
+ * @brief Maps a published segment read-only and validates its layout.
+ *
+ * @details Only the names are copied into the process, the columns are accessed
+ * directly in the shared pages.
+ */
+inline void SharedTable::attach(const std::string &p_name) {
+
+	this->detach();
+
+	int fd = shm_open(p_name.c_str(), O_RDONLY, 0);
+
+	if (fd < 0) {
+		throw std::runtime_error("Shared memory segment doesn't exist!");
+	}
+
+	struct stat status;
+
+	if (fstat(fd, &status) != 0 || (size_t) status.st_size < sizeof(Header)) {
+		close(fd);
+		throw std::runtime_error("Shared memory segment is not a published table!");
+	}
+
+	size_t size = status.st_size;
+	void *address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (address == MAP_FAILED) {
+		throw std::runtime_error("Error mapping shared memory segment!");
+	}
+
+	this->base = static_cast<const uint8_t*>(address);
+	this->mapped_size = size;
+	this->header = reinterpret_cast<const Header*>(this->base);
+
+	const Header *h = this->header;
+	uint64_t column_bytes = h->num_outputs * h->num_words * sizeof(uint64_t);
+
+	if (h->magic.load(std::memory_order_acquire) != MAGIC
+			|| h->version != VERSION || h->total_size > size
+			|| h->num_inputs > 63 || h->num_rows != (uint64_t(1) << h->num_inputs)
+			|| h->num_words != OutputColumn::num_words(h->num_rows)
+			|| h->columns_offset + column_bytes > h->total_size
+			|| (h->has_care && h->care_offset + column_bytes > h->total_size)
+			|| h->names_offset + h->names_size > h->total_size) {
+		this->detach();
+		throw std::runtime_error("Shared memory segment is not a published table!");
+	}
+
+	this->read_names();
+}
+
+/**
+ * @brief Reads the model, input and output names of the segment.
+ */
+inline void SharedTable::read_names() {
+
+	const uint8_t *pos = this->base + this->header->names_offset;
+	const uint8_t *end = pos + this->header->names_size;
+
+	auto next_name = [&]() {
+		uint32_t length = 0;
+
+		if (end - pos < (ptrdiff_t) sizeof(length)) {
+			return std::string();
+		}
+
+		std::memcpy(&length, pos, sizeof(length));
+		pos += sizeof(length);
+		length = std::min<uint64_t>(length, end - pos);
+
+		std::string name(reinterpret_cast<const char*>(pos), length);
+		pos += length;
+		return name;
+	};
+
+	this->model_name = next_name();
+
+	// The table may have been published without names
+	for (uint64_t i = 0; i < this->header->num_inputs && pos < end; i++) {
+		this->input_names.push_back(next_name());
+	}
+
+	for (uint64_t j = 0; j < this->header->num_outputs && pos < end; j++) {
+		this->output_names.push_back(next_name());
+	}
+}
+
+/**
+ * @brief Unmaps the segment. The segment itself stays published.
+ */
+inline void SharedTable::detach() {
+
+	if (this->base != nullptr) {
+		munmap(const_cast<uint8_t*>(this->base), this->mapped_size);
+	}
+
+	this->base = nullptr;
+	this->mapped_size = 0;
+	this->header = nullptr;
+
+	this->model_name.clear();
+	this->input_names.clear();
+	this->output_names.clear();
+}
+
+inline bool SharedTable::is_attached() const {
+	return this->header != nullptr;
+}
+
+inline int SharedTable::inputs() const {
+	return this->header->num_inputs;
+}
+
+inline int SharedTable::outputs() const {
+	return this->header->num_outputs;
+}
+
+inline uint64_t SharedTable::rows() const {
+	return this->header->num_rows;
+}
+
+/**
+ * @brief Returns the number of words of each column.
+ */
+inline uint64_t SharedTable::words() const {
+	return this->header->num_words;
+}
+
+/**
+ * @brief Returns the dense column of an output in the shared pages.
+ *
+ * @param p_output Index of the output, 0 <= p_output < outputs()
+ */
+inline const uint64_t* SharedTable::column(int p_output) const {
+	assert((p_output >= 0) && (p_output < this->outputs()));
+	return reinterpret_cast<const uint64_t*>(this->base + this->header->columns_offset)
+			+ p_output * this->header->num_words;
+}
+
+/**
+ * @brief Returns whether the published table has don't care rows.
+ */
+inline bool SharedTable::has_care_columns() const {
+	return this->header->has_care != 0;
+}
+
+/**
+ * @brief Returns the dense care mask of an output, requires has_care_columns().
+ */
+inline const uint64_t* SharedTable::care_column(int p_output) const {
+	assert(this->has_care_columns());
+	assert((p_output >= 0) && (p_output < this->outputs()));
+	return reinterpret_cast<const uint64_t*>(this->base + this->header->care_offset)
+			+ p_output * this->header->num_words;
+}
+
+/**
+ * @brief Returns the value of an output at a row.
+ */
+inline bool SharedTable::get(uint64_t p_row, int p_output) const {
+	return (this->column(p_output)[p_row >> 6] >> (p_row & 63)) & 1;
+}
+
+/**
+ * @brief Returns whether the value of an output is specified in a row.
+ */
+inline bool SharedTable::is_care(uint64_t p_row, int p_output) const {
+	return !this->has_care_columns()
+			|| ((this->care_column(p_output)[p_row >> 6] >> (p_row & 63)) & 1);
+}
+
+/**
+ * @brief Counts the rows in which a candidate differs from a specified output,
+ * see TruthTable::count_errors().
+ *
+ * @param p_output Index of the output
+ * @param p_words Dense bit vector of the candidate with words() words
+ */
+inline uint64_t SharedTable::count_errors(int p_output,
+		const uint64_t *p_words) const {
+
+	const uint64_t *target = this->column(p_output);
+	const uint64_t *care = this->has_care_columns() ?
+			this->care_column(p_output) : nullptr;
+
+	// Unused bits of the last word are cleared in the published columns
+	uint64_t tail = ((this->rows() & 63) != 0) ?
+			(uint64_t(1) << (this->rows() & 63)) - 1 : ~uint64_t(0);
+
+	return OutputColumn::count_differences(p_words, target, care, this->words(),
+			tail);
+}
+
+inline const std::string& SharedTable::get_model_name() const {
+	return this->model_name;
+}
+
+inline const std::vector<std::string>& SharedTable::get_input_names() const {
+	return this->input_names;
+}
+
+inline const std::vector<std::string>& SharedTable::get_output_names() const {
+	return this->output_names;
+}
+
+/**
+ * @brief Copies the published table into a private truth table.
+ *
+ * @details Only required for interfaces which need an owned TruthTable, the copy
+ * is packed with the allocation policy of the table. The rows are not expanded.
+ */
+template<class T>
+void SharedTable::load(TruthTable<T> &p_table) const {
+
+	p_table.clear();
+
+	uint64_t n_words = this->words();
+
+	std::vector<WordVector> words(this->outputs(),
+			WordVector(p_table.get_allocation_policy()));
+
+	for (int j = 0; j < this->outputs(); j++) {
+		words[j].assign(this->column(j), this->column(j) + n_words);
+	}
+
+	p_table.set_output_columns(words, this->rows());
+
+	if (this->has_care_columns()) {
+		for (int j = 0; j < this->outputs(); j++) {
+			words[j].assign(this->care_column(j), this->care_column(j) + n_words);
+		}
+
+		p_table.set_care_columns(words, this->rows());
+	}
+
+	p_table.set_model_name(this->model_name);
+	p_table.get_input_names() = this->input_names;
+	p_table.get_output_names() = this->output_names;
+}
+
+/**
+ * @brief Returns the number of bytes of the mapped segment.
+ */
+inline size_t SharedTable::memory_usage() const {
+	return this->mapped_size;
+}
+
+#endif /* SHAREDTABLE_H_ */
@@ -0,0 +1,398 @@
+#ifndef TABLEALLOCATOR_H_
+#define TABLEALLOCATOR_H_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * @brief Page size and NUMA placement of the large buffers of a table.
+ *
+ * @details Huge pages are either requested from the transparent huge page support of
+ * the kernel or from the explicitly reserved huge page pool, falling back to
+ * transparent and then to regular pages when none are available.
+ *
+ * The placement decides on which NUMA nodes the pages reside:
+ *
+ * 		LOCAL       : The node of the thread which touches a page first, which is
+ * 		              usually the allocating thread.
+ * 		INTERLEAVE  : Round robin across all online nodes.
+ * 		FIRST_TOUCH : The buffer is divided into num_threads contiguous slices. Slice
+ * 		              t is touched by a thread which calls bind_thread(t) first, so
+ * 		              the pages are placed on the node which bind_thread selects for
+ * 		              slice t, e.g. the node of the CPU of evaluator thread t. Without
+ * 		              bind_thread the buffer is left untouched and the pages are
+ * 		              placed like LOCAL by the thread which writes them first.
+ *
+ * The kernel migrates no pages afterwards, so FIRST_TOUCH only helps if the consumer
+ * pins its worker t to the node of slice t as well.
+ */
+struct AllocationPolicy {
+	enum HugePages {
+		NO_HUGE_PAGES = 0, TRANSPARENT_HUGE_PAGES = 1, EXPLICIT_HUGE_PAGES = 2
+	};
+
+	enum Placement {
+		LOCAL = 0, INTERLEAVE = 1, FIRST_TOUCH = 2
+	};
+
+	HugePages huge_pages = NO_HUGE_PAGES;
+	Placement placement = LOCAL;
+
+	// Slices of the FIRST_TOUCH placement, 0 selects the hardware concurrency
+	int num_threads = 0;
+
+	// Binds the calling thread to the CPUs of slice t, e.g. with sched_setaffinity,
+	// and must not throw
+	std::function<void(int)> bind_thread;
+};
+
+/*
+ * @brief Allocates the memory of table buffers according to an allocation policy.
+ *
+ * @details Buffers of at least LARGE_SIZE bytes are mapped directly from the kernel
+ * in multiples of 2 MiB, so that the policy can be applied to them before their pages
+ * are touched. Smaller buffers and platforms other than Linux use the global operator
+ * new. Whether a buffer is mapped only depends on its size, so a buffer can always be
+ * released without knowing the policy it was allocated with.
+ */
+class TableMemory {
+private:
+	static const size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+	static std::mutex& policy_mutex();
+	static AllocationPolicy& global_policy();
+
+	static size_t mapped_size(size_t p_bytes);
+	static bool explicit_huge_pages_supported();
+	static std::vector<int> online_nodes();
+
+	static void interleave(void *p_address, size_t p_bytes);
+	static void first_touch(void *p_address, size_t p_bytes,
+			const AllocationPolicy &p_policy);
+
+public:
+	static const size_t LARGE_SIZE = size_t(1) << 21;
+
+	static AllocationPolicy default_policy();
+	static void set_default_policy(const AllocationPolicy &p_policy);
+
+	static void* allocate(size_t p_bytes, const AllocationPolicy &p_policy);
+	static void deallocate(void *p_address, size_t p_bytes);
+};
+
+/*
+ * @brief Standard allocator which carries an allocation policy.
+ *
+ * @details Default constructed allocators use the process-wide default policy. The
+ * policy follows the buffer on copy, move and swap of a container.
+ */
+template<class T>
+class TableAllocator {
+private:
+	AllocationPolicy policy;
+
+	template<class U>
+	friend class TableAllocator;
+
+public:
+	typedef T value_type;
+
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+	typedef std::true_type is_always_equal;
+
+	TableAllocator() : policy(TableMemory::default_policy()) {}
+	TableAllocator(const AllocationPolicy &p_policy) : policy(p_policy) {}
+
+	template<class U>
+	TableAllocator(const TableAllocator<U> &p_other) : policy(p_other.policy) {}
+
+	T* allocate(size_t p_count) {
+		if (p_count > size_t(-1) / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(TableMemory::allocate(p_count * sizeof(T), this->policy));
+	}
+
+	void deallocate(T *p_address, size_t p_count) {
+		TableMemory::deallocate(p_address, p_count * sizeof(T));
+	}
+
+	const AllocationPolicy& get_policy() const {
+		return this->policy;
+	}
+
+	template<class U>
+	bool operator==(const TableAllocator<U>&) const {
+		return true;
+	}
+
+	template<class U>
+	bool operator!=(const TableAllocator<U>&) const {
+		return false;
+	}
+};
+
+inline std::mutex& TableMemory::policy_mutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+inline AllocationPolicy& TableMemory::global_policy() {
+	static AllocationPolicy policy;
+	return policy;
+}
+
+/**
+ * @brief Returns the policy of default constructed allocators.
+ */
+inline AllocationPolicy TableMemory::default_policy() {
+	std::lock_guard<std::mutex> lock(policy_mutex());
+	return global_policy();
+}
+
+/**
+ * @brief Sets the policy of allocators which are constructed afterwards.
+ */
+inline void TableMemory::set_default_policy(const AllocationPolicy &p_policy) {
+	std::lock_guard<std::mutex> lock(policy_mutex());
+	global_policy() = p_policy;
+}
+
+/**
+ * @brief Rounds the size of a mapped buffer up to a multiple of the huge page size.
+ */
+inline size_t TableMemory::mapped_size(size_t p_bytes) {
+	return (p_bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+/**
+ * @brief Checks whether the default size of explicit huge pages is 2 MiB.
+ *
+ * @details Mapped buffers are rounded to 2 MiB, so other huge page sizes can't be
+ * released by the size of the buffer.
+ */
+inline bool TableMemory::explicit_huge_pages_supported() {
+
+	static const bool supported = []() {
+		std::ifstream ifs("/proc/meminfo");
+		std::string line;
+
+		while (std::getline(ifs, line)) {
+			if (line.rfind("Hugepagesize:", 0) == 0) {
+				std::stringstream sstream(line.substr(13));
+				size_t size = 0;
+				sstream >> size;
+				return size * 1024 == HUGE_PAGE_SIZE;
+			}
+		}
+
+		return false;
+	}();
+
+	return supported;
+}
+
+/**
+ * @brief Returns the online NUMA nodes, e.g. {0, 1} for the list "0-1".
+ */
+inline std::vector<int> TableMemory::online_nodes() {
+
+	static const std::vector<int> nodes = []() {
+		std::vector<int> result;
+		std::ifstream ifs("/sys/devices/system/node/online");
+		std::string range;
+
+		while (std::getline(ifs, range, ',')) {
+			int first = 0;
+			int last = 0;
+			char separator = 0;
+
+			std::stringstream sstream(range);
+
+			if (!(sstream >> first)) {
+				continue;
+			}
+
+			last = first;
+
+			if (sstream >> separator >> last) {
+				last = std::max(first, last);
+			}
+
+			for (int node = first; node <= last; node++) {
+				result.push_back(node);
+			}
+		}
+
+		return result;
+	}();
+
+	return nodes;
+}
+
+/**
+ * @brief Interleaves the pages of a mapped buffer across all online NUMA nodes.
+ *
+ * @details Uses the mbind system call, so no NUMA library is required. The buffer
+ * keeps the default placement on single node systems or when the call fails.
+ */
+inline void TableMemory::interleave(void *p_address, size_t p_bytes) {
+
+#if defined(__linux__) && defined(SYS_mbind)
+	const int MPOL_INTERLEAVE_MODE = 3;
+
+	std::vector<int> nodes = online_nodes();
+
+	if (nodes.size() < 2) {
+		return;
+	}
+
+	unsigned long max_node = nodes.back() + 1;
+	std::vector<unsigned long> mask(max_node / (8 * sizeof(unsigned long)) + 1, 0);
+
+	for (int node : nodes) {
+		mask[node / (8 * sizeof(unsigned long))] |=
+				1UL << (node % (8 * sizeof(unsigned long)));
+	}
+
+	syscall(SYS_mbind, p_address, p_bytes, MPOL_INTERLEAVE_MODE, mask.data(),
+			max_node + 1, 0);
+#else
+	(void) p_address;
+	(void) p_bytes;
+#endif
+}
+
+/**
+ * @brief Touches the slices of a buffer from threads bound by the policy.
+ *
+ * @details Slice t is aligned to the huge page size and written by its own thread
+ * after bind_thread(t) has been called on it. Mapped pages are zero, so zeros are
+ * written. The calling thread touches nothing, so its binding is left unchanged.
+ */
+inline void TableMemory::first_touch(void *p_address, size_t p_bytes,
+		const AllocationPolicy &p_policy) {
+
+	if (!p_policy.bind_thread) {
+		return;
+	}
+
+	int num_slices = p_policy.num_threads;
+
+	if (num_slices <= 0) {
+		num_slices = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	const size_t page_size = 4096;
+
+	size_t num_units = p_bytes / HUGE_PAGE_SIZE;
+	char *base = static_cast<char*>(p_address);
+
+	num_slices = std::min<size_t>(num_slices, num_units);
+
+	auto touch = [&](int t) {
+		p_policy.bind_thread(t);
+
+		size_t begin = num_units * t / num_slices * HUGE_PAGE_SIZE;
+		size_t end = num_units * (t + 1) / num_slices * HUGE_PAGE_SIZE;
+
+		for (size_t offset = begin; offset < end; offset += page_size) {
+			base[offset] = 0;
+		}
+	};
+
+	std::vector<std::thread> workers;
+
+	for (int t = 0; t < num_slices; t++) {
+		workers.emplace_back(touch, t);
+	}
+
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+}
+
+/**
+ * @brief Allocates a buffer according to the policy.
+ *
+ * @throws std::bad_alloc if no memory is available
+ */
+inline void* TableMemory::allocate(size_t p_bytes,
+		const AllocationPolicy &p_policy) {
+
+#if defined(__linux__)
+	if (p_bytes >= LARGE_SIZE) {
+		size_t size = mapped_size(p_bytes);
+		void *address = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+		if (p_policy.huge_pages == AllocationPolicy::EXPLICIT_HUGE_PAGES
+				&& explicit_huge_pages_supported()) {
+			address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		}
+#endif
+
+		// Regular pages if the huge page pool is not available
+		if (address == MAP_FAILED) {
+			address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (address == MAP_FAILED) {
+				throw std::bad_alloc();
+			}
+
+#if defined(MADV_HUGEPAGE)
+			if (p_policy.huge_pages != AllocationPolicy::NO_HUGE_PAGES) {
+				madvise(address, size, MADV_HUGEPAGE);
+			}
+#endif
+		}
+
+		if (p_policy.placement == AllocationPolicy::INTERLEAVE) {
+			interleave(address, size);
+		} else if (p_policy.placement == AllocationPolicy::FIRST_TOUCH) {
+			first_touch(address, size, p_policy);
+		}
+
+		return address;
+	}
+#endif
+
+	return ::operator new(p_bytes);
+}
+
+/**
+ * @brief Releases a buffer which has been allocated with the given size.
+ */
+inline void TableMemory::deallocate(void *p_address, size_t p_bytes) {
+
+#if defined(__linux__)
+	if (p_bytes >= LARGE_SIZE) {
+		munmap(p_address, mapped_size(p_bytes));
+		return;
+	}
+#endif
+
+	::operator delete(p_address);
+}
+
+#endif /* TABLEALLOCATOR_H_ */
@@ -2,8 +2,16 @@
 #define TRUTHTABLE_H_
 
 #include <vector>
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
 #include <cassert>
 
+#include "OutputColumn.h"
+#include "InputPatternCache.h"
+
 /*
  * @brief Implements a truth table which stores the inputs and output
  *
@@ -29,16 +37,29 @@ private:
 	std::vector<std::vector<T>> inputs;
 	std::vector<std::vector<T>> outputs;
 
+	// Row-major inputs of a complete table, shared with all tables of its arity
+	std::shared_ptr<const std::vector<std::vector<T>>> shared_inputs;
+
+	std::vector<OutputColumn> output_columns;
+	std::vector<OutputColumn> care_columns;
+
 	std::vector<std::string> input_names;
 	std::vector<std::string> output_names;
 
 	std::string model_name;
 
 	bool compressed = false;
+
+	AllocationPolicy allocation_policy = TableMemory::default_policy();
 public:
 	TruthTable() = default;
+	TruthTable(const TruthTable&) = default;
+	TruthTable(TruthTable&&) = default;
 	virtual ~TruthTable() = default;
 
+	TruthTable& operator=(const TruthTable&) = default;
+	TruthTable& operator=(TruthTable&&) = default;
+
 	void append_inputs(std::vector<T> input_vec);
 	void append_outputs(std::vector<T> output_vec);
 
@@ -50,11 +71,14 @@ public:
 
 	std::vector<std::string>& get_input_names();
 	std::vector<std::string>& get_output_names();
+	const std::vector<std::string>& get_input_names() const;
+	const std::vector<std::string>& get_output_names() const;
 
 	void print_input_names();
 	void print_output_names();
 
 	const std::string get_model_name() const;
+	void set_model_name(std::string p_model_name);
 
 	bool is_compressed() const;
 	void set_compressed(bool p_compressed);
@@ -69,56 +93,336 @@ public:
 
 	void set_output_at(int p_row, int p_output, int p_val);
 
+	void set_output_columns(const std::vector<WordVector> &p_words,
+			uint64_t p_num_rows);
+	void pack_outputs();
+	void expand_outputs();
+	void release_rows();
+
+	int num_output_columns() const;
+	const OutputColumn& get_output_column(int p_output) const;
+	const std::vector<OutputColumn>& get_output_columns() const;
+
+	void set_care_columns(const std::vector<WordVector> &p_words,
+			uint64_t p_num_rows);
+	bool has_care_columns() const;
+	const OutputColumn& get_care_column(int p_output) const;
+	const std::vector<OutputColumn>& get_care_columns() const;
+	bool is_care(uint64_t p_row, int p_output) const;
+
+	uint64_t count_errors(int p_output, const uint64_t *p_words) const;
+
+	std::shared_ptr<const InputPatterns> get_input_patterns() const;
+
+	const AllocationPolicy& get_allocation_policy() const;
+	void set_allocation_policy(const AllocationPolicy &p_policy);
+
 };
 
+/**
+ * @brief Sets the row-major inputs to those of the complete table with n inputs.
+ *
+ * @details The table doesn't own the inputs. All tables with n inputs share one
+ * copy, which is taken from the InputPatternCache.
+ */
 template<class T>
 void TruthTable<T>::generate_inputs(int p_num_inputs) {
+	this->inputs.clear();
+	this->shared_inputs = InputPatternCache::rows<T>(p_num_inputs);
+}
+
+template<class T>
+void TruthTable<T>::init_outputs(int p_num_outputs, int p_num_rows) {
+	this->outputs.assign(p_num_rows, std::vector<T>(p_num_outputs, 0));
+}
+
+template<class T>
+void TruthTable<T>::set_output_at(int p_row, int p_output, int p_val) {
+	this->outputs.at(p_row).at(p_output) = p_val;
+}
+
+
+/**
+ * @brief Packs the given dense bit vectors into the output columns.
+ *
+ * @details The representation of each column is chosen by the density of
+ * its ON-set.
+ *
+ * @see OutputColumn
+ *
+ * @param p_words Dense bit vector for each output
+ * @param p_num_rows Number of rows of the table
+ */
+template<class T>
+void TruthTable<T>::set_output_columns(const std::vector<WordVector> &p_words,
+		uint64_t p_num_rows) {
+
+	this->output_columns.clear();
+	this->output_columns.reserve(p_words.size());
+
+	for (const WordVector &words : p_words) {
+		this->output_columns.emplace_back(words, p_num_rows,
+				this->allocation_policy);
+	}
+}
+
+/**
+ * @brief Packs the row-major 2D output vector into the output columns.
+ *
+ * @details Every value unequal to zero is treated as a set bit.
+ */
+template<class T>
+void TruthTable<T>::pack_outputs() {
+
+	if (this->outputs.size() == 0) {
+		throw std::runtime_error("Output data of the truth table is empty!");
+	}
 
-	int n;
-	int x = 0;
-	int rows = std::pow(2.0, p_num_inputs);
+	uint64_t num_rows = this->outputs.size();
+	int num_outputs = this->outputs.at(0).size();
 
-	std::vector<std::vector<T>> *input_table = new std::vector<std::vector<T> >(
-			rows, std::vector<T>(p_num_inputs, 0));
+	std::vector<WordVector> words(num_outputs,
+			WordVector(OutputColumn::num_words(num_rows), 0,
+					this->allocation_policy));
 
-	for (int i = p_num_inputs - 1; i >= 0; i--) {
-		n = std::pow(2.0, x);
-		for (int j = 0; j < rows; j++) {
-			if (j % (n * 2) >= n) {
-				(*input_table)[j][i] = 1;
+	for (uint64_t i = 0; i < num_rows; i++) {
+		for (int j = 0; j < num_outputs; j++) {
+			if (this->outputs[i][j] != 0) {
+				words[j][i >> 6] |= uint64_t(1) << (i & 63);
 			}
 		}
-		x++;
 	}
 
-	this->inputs = *input_table;
+	this->set_output_columns(words, num_rows);
 }
 
+/**
+ * @brief Rebuilds the row-major 2D output vector from the output columns.
+ */
 template<class T>
-void TruthTable<T>::init_outputs(int p_num_outputs, int p_num_rows) {
-	std::vector<std::vector<T>> *output_table = new std::vector<std::vector<T> >(
-				p_num_rows, std::vector<T>(p_num_outputs, 0));
+void TruthTable<T>::expand_outputs() {
 
-	this->outputs = *output_table;
+	if (this->output_columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	uint64_t num_rows = this->output_columns.at(0).rows();
+	int num_outputs = this->output_columns.size();
+
+	this->init_outputs(num_outputs, num_rows);
+
+	for (int j = 0; j < num_outputs; j++) {
+		this->output_columns[j].for_each_one([this, j](uint64_t row) {
+			this->outputs[row][j] = 1;
+		});
+	}
 }
 
+/**
+ * @brief Releases the memory of the row-major 2D input and output vectors.
+ *
+ * @details The output columns are kept. This is used to load large tables
+ * which are only accessed through the packed columns.
+ */
 template<class T>
-void TruthTable<T>::set_output_at(int p_row, int p_output, int p_val) {
-	this->outputs.at(p_row).at(p_output) = p_val;
+void TruthTable<T>::release_rows() {
+	std::vector<std::vector<T>>().swap(this->inputs);
+	std::vector<std::vector<T>>().swap(this->outputs);
+	this->shared_inputs.reset();
 }
 
+/**
+ * @brief Returns the number of packed output columns.
+ */
+template<class T>
+int TruthTable<T>::num_output_columns() const {
+	return this->output_columns.size();
+}
+
+/**
+ * @brief Returns the packed column of an output.
+ *
+ * @param p_output Index of the output, 0 <= p_output < num_output_columns()
+ */
+template<class T>
+const OutputColumn& TruthTable<T>::get_output_column(int p_output) const {
+	assert((p_output >= 0) && (p_output < (int ) this->output_columns.size()));
+	return this->output_columns.at(p_output);
+}
+
+/**
+ * @brief Returns a reference to the vector of packed output columns.
+ */
+template<class T>
+const std::vector<OutputColumn>& TruthTable<T>::get_output_columns() const {
+	return this->output_columns;
+}
+
+/**
+ * @brief Sets the care masks of an incompletely specified function.
+ *
+ * @details Bit r of the care mask of an output is cleared if the output is a
+ * don't care in row r. The output columns hold 0 in these rows. Passing no
+ * vectors marks the function as completely specified.
+ *
+ * @param p_words Dense care mask for each output
+ */
+template<class T>
+void TruthTable<T>::set_care_columns(const std::vector<WordVector> &p_words,
+		uint64_t p_num_rows) {
+
+	this->care_columns.clear();
+	this->care_columns.reserve(p_words.size());
+
+	for (const WordVector &words : p_words) {
+		this->care_columns.emplace_back(words, p_num_rows,
+				this->allocation_policy);
+	}
+}
+
+/**
+ * @brief Returns whether the table has don't care rows.
+ */
+template<class T>
+bool TruthTable<T>::has_care_columns() const {
+	return this->care_columns.size() > 0;
+}
+
+/**
+ * @brief Returns the care mask of an output.
+ *
+ * @param p_output Index of the output, requires has_care_columns()
+ */
+template<class T>
+const OutputColumn& TruthTable<T>::get_care_column(int p_output) const {
+	assert((p_output >= 0) && (p_output < (int ) this->care_columns.size()));
+	return this->care_columns.at(p_output);
+}
+
+/**
+ * @brief Returns a reference to the vector of care masks, empty if the function
+ * is completely specified.
+ */
+template<class T>
+const std::vector<OutputColumn>& TruthTable<T>::get_care_columns() const {
+	return this->care_columns;
+}
+
+/**
+ * @brief Returns whether the value of an output is specified in a row.
+ */
+template<class T>
+bool TruthTable<T>::is_care(uint64_t p_row, int p_output) const {
+	return this->care_columns.size() == 0
+			|| this->care_columns.at(p_output).get(p_row);
+}
+
+/**
+ * @brief Counts the rows in which a candidate differs from a specified output.
+ *
+ * @details The candidate is compared word by word. Don't care rows are masked
+ * out with a single AND per word.
+ *
+ * @param p_output Index of the output
+ * @param p_words Dense bit vector of the candidate with num_words(rows()) words
+ */
+template<class T>
+uint64_t TruthTable<T>::count_errors(int p_output,
+		const uint64_t *p_words) const {
+
+	const OutputColumn &column = this->output_columns.at(p_output);
+	const OutputColumn *care = (this->care_columns.size() > 0) ?
+			&this->care_columns.at(p_output) : nullptr;
+
+	const uint64_t BLOCK_WORDS = 256;
+
+	uint64_t n_words = OutputColumn::num_words(column.rows());
+	uint64_t errors = 0;
+
+	uint64_t target[BLOCK_WORDS];
+	uint64_t mask[BLOCK_WORDS];
+
+	// Unused bits of the last word are cleared in the packed columns
+	uint64_t tail = ((column.rows() & 63) != 0) ?
+			(uint64_t(1) << (column.rows() & 63)) - 1 : ~uint64_t(0);
+
+	for (uint64_t w = 0; w < n_words; w += BLOCK_WORDS) {
+		uint64_t count = std::min(BLOCK_WORDS, n_words - w);
+
+		column.copy_words(w, count, target);
+
+		if (care != nullptr) {
+			care->copy_words(w, count, mask);
+		}
+
+		errors += OutputColumn::count_differences(p_words + w, target,
+				(care != nullptr) ? mask : nullptr, count,
+				(w + count == n_words) ? tail : ~uint64_t(0));
+	}
+
+	return errors;
+}
+
+/**
+ * @brief Returns the packed input columns of the table.
+ *
+ * @details The input columns are not owned by the table. They are shared
+ * by all tables with the same number of inputs through the InputPatternCache
+ * and built on the first request.
+ */
+template<class T>
+std::shared_ptr<const InputPatterns> TruthTable<T>::get_input_patterns() const {
+
+	int num_inputs;
+
+	if (this->output_columns.size() > 0) {
+		num_inputs = __builtin_ctzll(this->output_columns.at(0).rows());
+	} else if (this->get_inputs().size() > 0) {
+		num_inputs = this->get_inputs().at(0).size();
+	} else {
+		throw std::runtime_error("Truth table is empty!");
+	}
+
+	return InputPatternCache::get(num_inputs);
+}
+
+/**
+ * @brief Returns the allocation policy of the output columns.
+ */
+template<class T>
+const AllocationPolicy& TruthTable<T>::get_allocation_policy() const {
+	return this->allocation_policy;
+}
+
+/**
+ * @brief Sets the allocation policy of output columns which are packed afterwards.
+ *
+ * @details Selects huge pages and the NUMA placement of the column data, see
+ * AllocationPolicy. Columns which already exist keep their memory.
+ */
+template<class T>
+void TruthTable<T>::set_allocation_policy(const AllocationPolicy &p_policy) {
+	this->allocation_policy = p_policy;
+}
 
 /**
  * @brief Appends an input row vector to the 2D input vector.
  *
- * @details Validates the input row vector by checking for nullptr and
- * emptiness.
+ * @details Validates the input row vector by checking for nullptr. The row is
+ * empty for functions without inputs, e.g. constants read from a PLU file.
  *
  * @param input_vec Input row vector
  */
 template<class T>
 void TruthTable<T>::append_inputs(std::vector<T> input_vec) {
-	assert(&input_vec != nullptr && !input_vec.empty());
+	assert(&input_vec != nullptr);
+
+	// The table takes a copy of shared inputs before it modifies them
+	if (this->shared_inputs) {
+		this->inputs = *this->shared_inputs;
+		this->shared_inputs.reset();
+	}
+
 	this->inputs.push_back(input_vec);
 }
 
@@ -147,9 +451,9 @@ void TruthTable<T>::append_outputs(std::vector<T> output_vec) {
  */
 template<class T>
 const std::vector<T>& TruthTable<T>::get_inputs_at(int index) const {
-	int max_index = this->inputs.size() - 1;
+	int max_index = this->get_inputs().size() - 1;
 	assert((index >= 0) && (index <= max_index));
-	return this->inputs.at(index);
+	return this->get_inputs().at(index);
 }
 
 /**
@@ -175,7 +479,7 @@ const std::vector<T>& TruthTable<T>::get_outputs_at(int index) const {
  */
 template<class T>
 const std::vector<std::vector<T>>& TruthTable<T>::get_inputs() const {
-	return inputs;
+	return this->shared_inputs ? *this->shared_inputs : this->inputs;
 }
 
 /**
@@ -204,6 +508,22 @@ std::vector<std::string>& TruthTable<T>::get_output_names() {
 	return output_names;
 }
 
+/**
+ *
+ */
+template<class T>
+const std::vector<std::string>& TruthTable<T>::get_input_names() const {
+	return input_names;
+}
+
+/**
+ *
+ */
+template<class T>
+const std::vector<std::string>& TruthTable<T>::get_output_names() const {
+	return output_names;
+}
+
 /**
  *
  */
@@ -225,22 +545,31 @@ void TruthTable<T>::print_output_names() {
 }
 
 /**
- * @brief Clears the input and output vector..
+ * @brief Clears the input and output vector as well as the output columns.
  */
 template<class T>
 void TruthTable<T>::clear() {
 	this->inputs.clear();
+	this->shared_inputs.reset();
 	this->outputs.clear();
+	this->output_columns.clear();
+	this->care_columns.clear();
 }
 
 /**
  * @brief Returns the number of rows of the table.
  *
+ * @details Falls back to the row count of the output columns when
+ * the row-major vectors have been released.
+ *
  * @return Number of rows.
  */
 template<class T>
 int TruthTable<T>::rows() {
-	return this->inputs.size();
+	if (this->get_inputs().size() == 0 && this->output_columns.size() > 0) {
+		return this->output_columns.at(0).rows();
+	}
+	return this->get_inputs().size();
 }
 
 /**
@@ -261,8 +590,10 @@ void TruthTable<T>::reset() {
 template<class T>
 void TruthTable<T>::print() {
 
+	const std::vector<std::vector<T>> &input_rows = this->get_inputs();
+
 	// Check whether the input vector contain any data
-	if (this->inputs.size() == 0) {
+	if (input_rows.size() == 0) {
 		throw std::runtime_error("Input data of the truth table is empty!");
 		return;
 	}
@@ -287,7 +618,7 @@ void TruthTable<T>::print() {
 	T input;
 	T output;
 
-	int num_inputs = this->inputs.at(0).size();
+	int num_inputs = input_rows.at(0).size();
 	int num_outputs = this->outputs.at(0).size();
 
 	// Iterate over the number of rows
@@ -295,7 +626,7 @@ void TruthTable<T>::print() {
 
 		// Print the data of the current input row vector
 		for (int j = 0; j < num_inputs; j++) {
-			input = this->inputs.at(i).at(j);
+			input = input_rows.at(i).at(j);
 			std::cout << input << " ";
 		}
 
@@ -311,9 +642,29 @@ void TruthTable<T>::print() {
 	}
 }
 
+/**
+ * @brief Returns the model name of the table.
+ */
+template<class T>
+const std::string TruthTable<T>::get_model_name() const {
+	return this->model_name;
+}
+
+/**
+ * @brief Sets the model name of the table.
+ */
+template<class T>
+void TruthTable<T>::set_model_name(std::string p_model_name) {
+	this->model_name = p_model_name;
+}
+
 /**
  * @brief Returns the state of the compressed property.
  *
+ * @details A compressed table holds the 32-row chunks of a PLU file in its
+ * row-major vectors instead of single rows. The output columns are expanded in
+ * either case.
+ *
  * @return State of the compressed property.
  */
 template<class T>
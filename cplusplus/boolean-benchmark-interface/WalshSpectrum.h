@@ -0,0 +1,416 @@
+#ifndef WALSHSPECTRUM_H_
+#define WALSHSPECTRUM_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "OutputColumn.h"
+#include "TruthTable.h"
+#include "ParallelFor.h"
+
+/*
+ * @brief Spectral metrics of a single output.
+ *
+ * @details The nonlinearity is the Hamming distance to the nearest affine function,
+ * the absolute indicator is the largest absolute autocorrelation of a nonzero shift.
+ */
+struct WalshSummary {
+	int64_t max_walsh = 0;
+	uint64_t nonlinearity = 0;
+	int64_t absolute_indicator = 0;
+};
+
+/*
+ * @brief Walsh-Hadamard spectrum, autocorrelation and nonlinearity of output columns.
+ *
+ * @details The Walsh coefficient at a is W(a) = sum over x of (-1)^(f(x) + a.x), where
+ * a and x are row indices, i.e. bit k of a refers to bit k of the row index and input 0
+ * is the most significant bit. The spectrum is computed in place by the fast
+ * Walsh-Hadamard transform. The butterflies of the first stages are applied block by
+ * block, so that a block stays in the L1 cache for all of its stages. The remaining
+ * stages are combined pairwise into radix-4 passes to halve the passes over the array.
+ * The additions are vectorized with AVX-512, AVX2 or SSE2, depending on the instruction
+ * set the file is compiled for. The default flags of the Makefile only enable SSE2 on
+ * x86-64, the AVX2 and AVX-512 butterflies need e.g. make ARCH=-march=native.
+ *
+ * The coefficients are bounded by 2^n, so spectrum() accepts 32 bit integers for up to
+ * 30 inputs and 64 bit integers otherwise. The autocorrelation is obtained from the
+ * transform of the squared spectrum and is computed with 64 bit integers for up to 31
+ * inputs. The summaries square the spectrum in place, so they need 8 bytes per row.
+ */
+class WalshSpectrum {
+private:
+	// Elements of a block which is transformed within the L1 cache
+	static constexpr uint64_t BLOCK_SIZE = 1 << 12;
+
+	static void add_sub(int32_t *p_a, int32_t *p_b, uint64_t p_count);
+	static void add_sub(int64_t *p_a, int64_t *p_b, uint64_t p_count);
+
+	template<class I>
+	static void load_signs(const OutputColumn &p_column, I *p_data);
+
+	static int max_workers(uint64_t p_num_rows);
+
+public:
+	static const int MAX_SPECTRUM_INPUTS = 34;
+	static const int MAX_AUTOCORRELATION_INPUTS = 31;
+
+	template<class I>
+	static void transform(I *p_data, uint64_t p_size);
+
+	template<class I>
+	static void spectrum(const OutputColumn &p_column, std::vector<I> &p_spectrum);
+	static void autocorrelation(const OutputColumn &p_column,
+			std::vector<int64_t> &p_autocorrelation);
+
+	static WalshSummary summarize_output(const OutputColumn &p_column);
+	template<class T>
+	static std::vector<WalshSummary> analyze(const TruthTable<T> &p_table,
+			int p_num_threads = 0);
+};
+
+/**
+ * @brief Replaces a[i], b[i] by a[i] + b[i], a[i] - b[i].
+ */
+inline void WalshSpectrum::add_sub(int32_t *p_a, int32_t *p_b, uint64_t p_count) {
+
+	uint64_t i = 0;
+
+#if defined(__AVX512F__)
+	for (; i + 16 <= p_count; i += 16) {
+		__m512i a = _mm512_loadu_si512((const void*) (p_a + i));
+		__m512i b = _mm512_loadu_si512((const void*) (p_b + i));
+		_mm512_storeu_si512((void*) (p_a + i), _mm512_add_epi32(a, b));
+		_mm512_storeu_si512((void*) (p_b + i), _mm512_sub_epi32(a, b));
+	}
+#endif
+
+#if defined(__AVX2__)
+	for (; i + 8 <= p_count; i += 8) {
+		__m256i a = _mm256_loadu_si256((const __m256i*) (p_a + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*) (p_b + i));
+		_mm256_storeu_si256((__m256i*) (p_a + i), _mm256_add_epi32(a, b));
+		_mm256_storeu_si256((__m256i*) (p_b + i), _mm256_sub_epi32(a, b));
+	}
+#endif
+
+#if defined(__SSE2__)
+	for (; i + 4 <= p_count; i += 4) {
+		__m128i a = _mm_loadu_si128((const __m128i*) (p_a + i));
+		__m128i b = _mm_loadu_si128((const __m128i*) (p_b + i));
+		_mm_storeu_si128((__m128i*) (p_a + i), _mm_add_epi32(a, b));
+		_mm_storeu_si128((__m128i*) (p_b + i), _mm_sub_epi32(a, b));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		int32_t a = p_a[i];
+		int32_t b = p_b[i];
+		p_a[i] = a + b;
+		p_b[i] = a - b;
+	}
+}
+
+/**
+ * @brief Replaces a[i], b[i] by a[i] + b[i], a[i] - b[i].
+ */
+inline void WalshSpectrum::add_sub(int64_t *p_a, int64_t *p_b, uint64_t p_count) {
+
+	uint64_t i = 0;
+
+#if defined(__AVX512F__)
+	for (; i + 8 <= p_count; i += 8) {
+		__m512i a = _mm512_loadu_si512((const void*) (p_a + i));
+		__m512i b = _mm512_loadu_si512((const void*) (p_b + i));
+		_mm512_storeu_si512((void*) (p_a + i), _mm512_add_epi64(a, b));
+		_mm512_storeu_si512((void*) (p_b + i), _mm512_sub_epi64(a, b));
+	}
+#endif
+
+#if defined(__AVX2__)
+	for (; i + 4 <= p_count; i += 4) {
+		__m256i a = _mm256_loadu_si256((const __m256i*) (p_a + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*) (p_b + i));
+		_mm256_storeu_si256((__m256i*) (p_a + i), _mm256_add_epi64(a, b));
+		_mm256_storeu_si256((__m256i*) (p_b + i), _mm256_sub_epi64(a, b));
+	}
+#endif
+
+#if defined(__SSE2__)
+	for (; i + 2 <= p_count; i += 2) {
+		__m128i a = _mm_loadu_si128((const __m128i*) (p_a + i));
+		__m128i b = _mm_loadu_si128((const __m128i*) (p_b + i));
+		_mm_storeu_si128((__m128i*) (p_a + i), _mm_add_epi64(a, b));
+		_mm_storeu_si128((__m128i*) (p_b + i), _mm_sub_epi64(a, b));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		int64_t a = p_a[i];
+		int64_t b = p_b[i];
+		p_a[i] = a + b;
+		p_b[i] = a - b;
+	}
+}
+
+/**
+ * @brief Applies the unnormalized Walsh-Hadamard transform in place.
+ *
+ * @param p_data Array of 32 or 64 bit integers
+ * @param p_size Number of elements, a power of two
+ */
+template<class I>
+void WalshSpectrum::transform(I *p_data, uint64_t p_size) {
+
+	if (p_size == 0 || (p_size & (p_size - 1)) != 0) {
+		throw std::runtime_error("Size of the transform is not a power of two!");
+	}
+
+	uint64_t block = std::min(p_size, BLOCK_SIZE);
+
+	// Stages with a distance below the block size stay within one block
+	for (uint64_t b = 0; b < p_size; b += block) {
+		I *data = p_data + b;
+		uint64_t h = 1;
+
+		// The first two stages on groups of four elements
+		if (block >= 4) {
+			for (uint64_t i = 0; i < block; i += 4) {
+				I x0 = data[i] + data[i + 1];
+				I x1 = data[i] - data[i + 1];
+				I x2 = data[i + 2] + data[i + 3];
+				I x3 = data[i + 2] - data[i + 3];
+
+				data[i] = x0 + x2;
+				data[i + 1] = x1 + x3;
+				data[i + 2] = x0 - x2;
+				data[i + 3] = x1 - x3;
+			}
+
+			h = 4;
+		}
+
+		for (; h < block; h <<= 1) {
+			for (uint64_t i = 0; i < block; i += h << 1) {
+				add_sub(data + i, data + i + h, h);
+			}
+		}
+	}
+
+	uint64_t h = block;
+
+	// Two stages per pass over the array
+	for (; (h << 2) <= p_size; h <<= 2) {
+		for (uint64_t i = 0; i < p_size; i += h << 2) {
+			for (uint64_t j = 0; j < h; j += block) {
+				I *data = p_data + i + j;
+				uint64_t count = std::min(block, h - j);
+
+				add_sub(data, data + h, count);
+				add_sub(data + 2 * h, data + 3 * h, count);
+				add_sub(data, data + 2 * h, count);
+				add_sub(data + h, data + 3 * h, count);
+			}
+		}
+	}
+
+	// Remaining single stage
+	if (h < p_size) {
+		add_sub(p_data, p_data + h, h);
+	}
+}
+
+/**
+ * @brief Writes (-1)^f(x) for every row x of the column.
+ */
+template<class I>
+void WalshSpectrum::load_signs(const OutputColumn &p_column, I *p_data) {
+
+	uint64_t num_rows = p_column.rows();
+	uint64_t word = 0;
+
+	for (uint64_t r = 0; r < num_rows; r++) {
+		if ((r & 63) == 0) {
+			p_column.copy_words(r >> 6, 1, &word);
+		}
+
+		p_data[r] = 1 - 2 * (I) ((word >> (r & 63)) & 1);
+	}
+}
+
+/**
+ * @brief Computes the Walsh spectrum of an output column.
+ *
+ * @tparam I int32_t for up to 30 inputs or int64_t
+ *
+ * @param p_column Output column whose number of rows is a power of two
+ * @param p_spectrum Target vector, resized to the number of rows
+ */
+template<class I>
+void WalshSpectrum::spectrum(const OutputColumn &p_column,
+		std::vector<I> &p_spectrum) {
+
+	uint64_t num_rows = p_column.rows();
+
+	if (num_rows == 0 || (num_rows & (num_rows - 1)) != 0) {
+		throw std::runtime_error("Number of rows is not a power of two!");
+	}
+
+	int n = __builtin_ctzll(num_rows);
+
+	if (n > MAX_SPECTRUM_INPUTS || (sizeof(I) < 8 && n > 30)) {
+		throw std::runtime_error("Number of inputs exceeds the spectrum accumulators!");
+	}
+
+	p_spectrum.resize(num_rows);
+
+	load_signs(p_column, p_spectrum.data());
+	transform(p_spectrum.data(), num_rows);
+}
+
+/**
+ * @brief Computes the autocorrelation r(d) = sum over x of (-1)^(f(x) + f(x ^ d)).
+ *
+ * @details By the Wiener-Khinchin theorem, r is the transform of the squared spectrum
+ * divided by the number of rows.
+ *
+ * @param p_column Output column with at most 31 inputs
+ * @param p_autocorrelation Target vector, resized to the number of rows
+ */
+inline void WalshSpectrum::autocorrelation(const OutputColumn &p_column,
+		std::vector<int64_t> &p_autocorrelation) {
+
+	uint64_t num_rows = p_column.rows();
+
+	if (num_rows > (uint64_t(1) << MAX_AUTOCORRELATION_INPUTS)) {
+		throw std::runtime_error("Number of inputs exceeds the autocorrelation accumulators!");
+	}
+
+	spectrum(p_column, p_autocorrelation);
+
+	int n = __builtin_ctzll(num_rows);
+
+	for (int64_t &w : p_autocorrelation) {
+		w *= w;
+	}
+
+	transform(p_autocorrelation.data(), num_rows);
+
+	for (int64_t &r : p_autocorrelation) {
+		r >>= n;
+	}
+}
+
+/**
+ * @brief Computes the maximum Walsh coefficient, nonlinearity and absolute indicator.
+ *
+ * @details The spectrum is squared in place in a single 64 bit buffer and transformed
+ * again for the autocorrelation, so a column needs 8 bytes per row. The absolute
+ * indicator is only computed for up to 31 inputs and is 0 for larger columns.
+ */
+inline WalshSummary WalshSpectrum::summarize_output(const OutputColumn &p_column) {
+
+	WalshSummary summary;
+	std::vector<int64_t> walsh;
+
+	spectrum(p_column, walsh);
+
+	uint64_t num_rows = p_column.rows();
+	int n = __builtin_ctzll(num_rows);
+
+	for (int64_t w : walsh) {
+		summary.max_walsh = std::max<int64_t>(summary.max_walsh, std::llabs(w));
+	}
+
+	summary.nonlinearity = (num_rows - summary.max_walsh) / 2;
+
+	if (n > MAX_AUTOCORRELATION_INPUTS) {
+		return summary;
+	}
+
+	for (int64_t &w : walsh) {
+		w *= w;
+	}
+
+	transform(walsh.data(), num_rows);
+
+	for (uint64_t d = 1; d < num_rows; d++) {
+		summary.absolute_indicator = std::max<int64_t>(summary.absolute_indicator,
+				std::llabs(walsh[d] >> n));
+	}
+
+	return summary;
+}
+
+/**
+ * @brief Returns the number of columns which can be summarized at the same time in
+ * half of the physical memory, at least 1.
+ */
+inline int WalshSpectrum::max_workers(uint64_t p_num_rows) {
+
+#if defined(__unix__) && defined(_SC_PHYS_PAGES)
+	long pages = sysconf(_SC_PHYS_PAGES);
+	long page_size = sysconf(_SC_PAGESIZE);
+
+	if (pages > 0 && page_size > 0) {
+		uint64_t budget = uint64_t(pages) * uint64_t(page_size) / 2;
+		uint64_t workers = budget / (p_num_rows * sizeof(int64_t));
+
+		return (int) std::max<uint64_t>(1, std::min<uint64_t>(workers, 1 << 20));
+	}
+#endif
+
+	return 1 << 20;
+}
+
+/**
+ * @brief Computes the spectral metrics of all outputs of a table.
+ *
+ * @details Requires the packed output columns of the table. Each worker holds the
+ * spectrum of one output at a time, i.e. 8 bytes per row, so the number of workers is
+ * capped at the number of spectra which fit into half of the physical memory. The
+ * spectrum is only defined for completely
+ * specified functions, so tables with don't cares are rejected instead of treating
+ * the don't cares as 0.
+ *
+ * @param p_table Truth table with packed output columns
+ * @param p_num_threads Number of worker threads, 0 selects the hardware concurrency
+ */
+template<class T>
+std::vector<WalshSummary> WalshSpectrum::analyze(const TruthTable<T> &p_table,
+		int p_num_threads) {
+
+	const std::vector<OutputColumn> &columns = p_table.get_output_columns();
+
+	if (columns.size() == 0) {
+		throw std::runtime_error("Output columns of the truth table are empty!");
+	}
+
+	if (p_table.has_care_columns()) {
+		throw std::runtime_error("Truth table has don't care rows!");
+	}
+
+	std::vector<WalshSummary> summaries(columns.size());
+
+	int workers = std::min(parallel_workers(columns.size(), p_num_threads),
+			max_workers(columns.at(0).rows()));
+
+	parallel_for(columns.size(), workers, [&](uint64_t p_output, int) {
+		summaries[p_output] = summarize_output(columns[p_output]);
+	});
+
+	return summaries;
+}
+
+#endif /* WALSHSPECTRUM_H_ */
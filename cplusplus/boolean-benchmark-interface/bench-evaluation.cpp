@@ -0,0 +1,169 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Compares the evaluation of a candidate against a multiplier
+//               in the row-major layout, per output column and with the
+//               cache-blocked BlockedEvaluator.
+//
+//               Usage: bench-evaluation [bits] [repetitions] [threads]
+//
+//               The multiplier of two operands with the given number of bits
+//               has 2 * bits inputs and outputs. The candidate computes output
+//               j as the XOR of two inputs. Prints the seconds per evaluation
+//               and the bandwidth over the target columns of each variant, and
+//               whether the popcount instruction is used, see ARCH in the
+//               Makefile.
+//============================================================================
+
+#include <iostream>
+#include <chrono>
+#include <string>
+
+#include "BenchmarkGenerator.h"
+#include "BlockedEvaluator.h"
+#include "InputPatternCache.h"
+#include "TruthTable.h"
+
+static double seconds_since(std::chrono::steady_clock::time_point p_start) {
+	return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - p_start).count();
+}
+
+/*
+ * Runs the evaluation repeatedly and returns the seconds per run.
+ */
+template<class F>
+static double measure(int p_repetitions, F p_func) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int k = 0; k < p_repetitions; k++) {
+		p_func();
+	}
+
+	return seconds_since(start) / p_repetitions;
+}
+
+static void report(const std::string &p_name, double p_seconds, uint64_t p_bytes,
+		uint64_t p_errors) {
+
+	std::cout << p_name << ": " << p_seconds << " s, " << p_bytes / p_seconds / 1e9
+			<< " GB/s, " << p_errors << " errors" << std::endl;
+}
+
+int main(int argc, char **argv) {
+
+	int bits = (argc > 1) ? std::stoi(argv[1]) : 10;
+	int repetitions = (argc > 2) ? std::stoi(argv[2]) : 5;
+	int threads = (argc > 3) ? std::stoi(argv[3]) : 1;
+
+	if (bits < 1 || 2 * bits > 26 || repetitions < 1) {
+		std::cerr << "Usage: bench-evaluation [bits] [repetitions] [threads]"
+				<< std::endl << "The number of bits must be between 1 and 13."
+				<< std::endl;
+		return 1;
+	}
+
+	int n = 2 * bits;
+
+	TruthTable<int> table = BenchmarkGenerator::multiplier<int>(bits);
+	table.expand_outputs();
+
+	std::shared_ptr<const InputPatterns> patterns = InputPatternCache::get(n);
+
+	int m = table.num_output_columns();
+	uint64_t num_rows = uint64_t(1) << n;
+	uint64_t num_words = OutputColumn::num_words(num_rows);
+
+	auto candidate_word = [&](int p_output, uint64_t p_word) {
+		return patterns->column(p_output % n)[p_word]
+				^ patterns->column((p_output + 1) % n)[p_word];
+	};
+
+	std::vector<uint64_t> candidate(m * num_words);
+
+	for (int j = 0; j < m; j++) {
+		for (uint64_t w = 0; w < num_words; w++) {
+			candidate[j * num_words + w] = candidate_word(j, w);
+		}
+	}
+
+	BlockedEvaluator evaluator(table);
+
+	std::cout << "multiplier " << bits << "x" << bits << ": " << num_rows << " rows, "
+			<< m << " outputs, " << evaluator.blocks() << " blocks of "
+			<< evaluator.block_words() << " words" << std::endl;
+
+#if defined(__POPCNT__)
+	std::cout << "popcount: POPCNT instruction" << std::endl;
+#else
+	std::cout << "popcount: software, build with ARCH=-mpopcnt or ARCH=-march=native"
+			<< std::endl;
+#endif
+
+	uint64_t bytes = m * num_words * sizeof(uint64_t);
+	std::vector<uint64_t> errors(m);
+
+	auto total = [&]() {
+		uint64_t sum = 0;
+		for (uint64_t e : errors) {
+			sum += e;
+		}
+		return sum;
+	};
+
+	// Row-major: one vector of outputs per row
+	double seconds = measure(repetitions, [&]() {
+		std::fill(errors.begin(), errors.end(), 0);
+
+		for (uint64_t r = 0; r < num_rows; r++) {
+			const std::vector<int> &outputs = table.get_outputs_at(r);
+
+			for (int j = 0; j < m; j++) {
+				int bit = (candidate[j * num_words + (r >> 6)] >> (r & 63)) & 1;
+				errors[j] += (outputs[j] != bit);
+			}
+		}
+	});
+
+	std::vector<uint64_t> expected = errors;
+	report("row-major", seconds, bytes, total());
+
+	seconds = measure(repetitions, [&]() {
+		for (int j = 0; j < m; j++) {
+			errors[j] = table.count_errors(j, candidate.data() + j * num_words);
+		}
+	});
+
+	report("per-column", seconds, bytes, total());
+	bool agree = (errors == expected);
+
+	seconds = measure(repetitions, [&]() {
+		evaluator.count_errors(candidate.data(), errors.data(), threads);
+	});
+
+	report("blocked", seconds, bytes, total());
+	agree = agree && (errors == expected);
+
+	// The candidate is computed block by block and compared while it is cached
+	seconds = measure(repetitions, [&]() {
+		evaluator.evaluate([&](uint64_t p_begin, uint64_t p_count, uint64_t *p_tile) {
+			for (int j = 0; j < m; j++) {
+				uint64_t *words = p_tile + j * evaluator.block_words();
+
+				for (uint64_t w = 0; w < p_count; w++) {
+					words[w] = candidate_word(j, p_begin + w);
+				}
+			}
+		}, errors.data(), threads);
+	});
+
+	report("blocked-generated", seconds, bytes, total());
+	agree = agree && (errors == expected);
+
+	if (!agree) {
+		std::cerr << "The error counts of the variants differ!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
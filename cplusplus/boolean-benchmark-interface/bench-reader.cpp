@@ -0,0 +1,85 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Timing driver of the C++ interface for the cross-language
+//               throughput harness (harness/run_harness.py).
+//
+//               Usage: bench-reader <file.tt|file.pla>
+//
+//               Prints one RESULT line with the seconds spent on reading the
+//               header, the body into packed columns and the expansion into
+//               the row-major vectors, followed by the peak resident set size
+//               of the process in KiB.
+//============================================================================
+
+#include <chrono>
+
+#include "BenchmarkFileReader.h"
+#include "TruthTable.h"
+
+static double seconds_since(std::chrono::steady_clock::time_point p_start) {
+	return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - p_start).count();
+}
+
+/*
+ * Returns the peak resident set size of the process in KiB (VmHWM),
+ * or 0 if /proc is not available.
+ */
+static long peak_rss() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+
+	while (std::getline(status, line)) {
+		if (line.rfind("VmHWM:", 0) == 0) {
+			return std::stol(line.substr(6));
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv) {
+
+	if (argc < 2) {
+		std::cerr << "Usage: bench-reader <file.tt|file.pla>" << std::endl;
+		return 1;
+	}
+
+	std::string file_path = argv[1];
+	std::string extension = std::filesystem::path(file_path).extension();
+
+	BenchmarkFileReader<int> reader;
+	reader.set_keep_rows(false);
+
+	auto start = std::chrono::steady_clock::now();
+
+	reader.open_file(file_path);
+	reader.read_header();
+
+	double header = seconds_since(start);
+	start = std::chrono::steady_clock::now();
+
+	if (extension == ".tt") {
+		reader.read_tt_file(file_path);
+	} else if (extension == ".pla") {
+		reader.read_pla_file(file_path);
+	} else {
+		std::cout << "UNSUPPORTED" << std::endl;
+		return 0;
+	}
+
+	double body = seconds_since(start);
+	start = std::chrono::steady_clock::now();
+
+	TruthTable<int> table = reader.get_truth_table();
+	table.generate_inputs(reader.get_num_inputs());
+	table.expand_outputs();
+
+	double expand = seconds_since(start);
+
+	std::cout << "RESULT header=" << header << " body=" << body << " expand="
+			<< expand << " rows=" << table.rows() << " rss=" << peak_rss()
+			<< std::endl;
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Builds or updates the catalog of a benchmark directory and
+//               lists the files which match the given bounds.
+//
+//               Usage: benchmark-catalog <directory> [-i min:max] [-o min:max]
+//                                        [-p min:max] [-m model]
+//
+//               The bounds select the number of inputs, outputs and product
+//               terms, a missing minimum or maximum is unbounded, e.g. -i 8:
+//============================================================================
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+
+#include "BenchmarkCatalog.h"
+
+template<class I>
+static void parse_range(const std::string &p_range, I &p_min, I &p_max) {
+
+	size_t separator = p_range.find(':');
+
+	if (separator == std::string::npos) {
+		p_min = p_max = std::stoll(p_range);
+		return;
+	}
+
+	if (separator > 0) {
+		p_min = std::stoll(p_range.substr(0, separator));
+	}
+
+	if (separator + 1 < p_range.size()) {
+		p_max = std::stoll(p_range.substr(separator + 1));
+	}
+}
+
+int main(int argc, char **argv) {
+
+	if (argc < 2 || argc % 2 != 0) {
+		std::cerr << "Usage: " << argv[0]
+				<< " <directory> [-i min:max] [-o min:max] [-p min:max] [-m model]"
+				<< std::endl;
+		return 1;
+	}
+
+	CatalogFilter filter;
+
+	for (int a = 2; a < argc; a += 2) {
+		if (std::strcmp(argv[a], "-i") == 0) {
+			parse_range(argv[a + 1], filter.min_inputs, filter.max_inputs);
+		} else if (std::strcmp(argv[a], "-o") == 0) {
+			parse_range(argv[a + 1], filter.min_outputs, filter.max_outputs);
+		} else if (std::strcmp(argv[a], "-p") == 0) {
+			parse_range(argv[a + 1], filter.min_product_terms, filter.max_product_terms);
+		} else if (std::strcmp(argv[a], "-m") == 0) {
+			filter.model_name = argv[a + 1];
+		} else {
+			std::cerr << "Unknown option " << argv[a] << std::endl;
+			return 1;
+		}
+	}
+
+	static const char *formats[] = { "plu", "pla", "tt" };
+
+	auto start = std::chrono::steady_clock::now();
+
+	BenchmarkCatalog catalog;
+	int num_scanned = catalog.load(argv[1]);
+
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+
+	for (const CatalogEntry *entry : catalog.select(filter)) {
+		std::cout << entry->path << "\t" << formats[entry->format] << "\t"
+				<< entry->model_name << "\ti=" << entry->num_inputs
+				<< "\to=" << entry->num_outputs << "\tp=" << entry->num_product_terms
+				<< "\t" << std::hex << std::setw(16) << std::setfill('0')
+				<< entry->hash << std::dec << std::setfill(' ') << "\n";
+	}
+
+	std::cerr << catalog.get_entries().size() << " files, " << num_scanned
+			<< " scanned in " << seconds * 1000 << " ms" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,284 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Implementation of the C ABI over the C++ benchmark reader,
+//               built as shared library for the Python and Java interfaces.
+//============================================================================
+
+#include "benchmark_c_api.h"
+#include "BenchmarkFileReader.h"
+
+/*
+ * Opaque table handle which owns the reader and the packed output columns.
+ */
+struct bbi_table {
+	BenchmarkFileReader<int> reader;
+
+	// Dense copies of the compressed columns when BBI_LOAD_DENSE is requested
+	std::vector<OutputColumn> dense_columns;
+	std::vector<OutputColumn> dense_care_columns;
+
+	const std::vector<OutputColumn> *columns = nullptr;
+	const std::vector<OutputColumn> *care_columns = nullptr;
+};
+
+// Message of the last error of the calling thread
+static thread_local std::string last_error;
+
+static int set_error(const std::string &p_message) {
+	last_error = p_message;
+	return BBI_ERROR;
+}
+
+static bool valid_output(const bbi_table *p_table, int p_output) {
+	if (p_table == nullptr || p_output < 0
+			|| p_output >= (int) p_table->columns->size()) {
+		set_error("Invalid table handle or output index!");
+		return false;
+	}
+	return true;
+}
+
+static bool valid_care_output(const bbi_table *p_table, int p_output) {
+	if (p_table == nullptr || p_output < 0
+			|| p_output >= (int) p_table->care_columns->size()) {
+		set_error("Invalid table handle, output index or table without care masks!");
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Repacks the columns as dense bit vectors.
+ */
+static void repack_dense(const std::vector<OutputColumn> &p_columns,
+		std::vector<OutputColumn> &p_dense) {
+
+	WordVector words;
+
+	for (const OutputColumn &column : p_columns) {
+		column.to_words(words);
+		p_dense.emplace_back(words, column.rows(), OutputColumn::DENSE);
+	}
+}
+
+int bbi_abi_version(void) {
+	return BBI_ABI_VERSION;
+}
+
+const char* bbi_last_error(void) {
+	return last_error.c_str();
+}
+
+int bbi_table_load(const char *file_path, int flags, bbi_table **table) {
+
+	if (file_path == nullptr || table == nullptr) {
+		return set_error("File path or table pointer is null!");
+	}
+
+	*table = nullptr;
+
+	try {
+		std::unique_ptr<bbi_table> handle(new bbi_table());
+
+		// Only the packed columns are exposed, the row-major vectors are dropped
+		handle->reader.set_keep_rows(false);
+		handle->reader.read_file(file_path);
+
+		const TruthTable<int> &truth_table = handle->reader.get_truth_table();
+
+		handle->columns = &truth_table.get_output_columns();
+		handle->care_columns = &truth_table.get_care_columns();
+
+		// Repack compressed columns so that every buffer is a dense bit vector
+		if (flags & BBI_LOAD_DENSE) {
+			repack_dense(*handle->columns, handle->dense_columns);
+			repack_dense(*handle->care_columns, handle->dense_care_columns);
+
+			handle->columns = &handle->dense_columns;
+			handle->care_columns = &handle->dense_care_columns;
+		}
+
+		*table = handle.release();
+		return BBI_OK;
+
+	} catch (const std::exception &e) {
+		return set_error(e.what());
+	} catch (...) {
+		return set_error("Unknown error while loading the benchmark file!");
+	}
+}
+
+void bbi_table_free(bbi_table *table) {
+	delete table;
+}
+
+int bbi_table_num_inputs(const bbi_table *table) {
+	return (table != nullptr) ? table->reader.get_num_inputs() : -1;
+}
+
+int bbi_table_num_outputs(const bbi_table *table) {
+	return (table != nullptr) ? (int) table->columns->size() : -1;
+}
+
+uint64_t bbi_table_num_rows(const bbi_table *table) {
+	if (table == nullptr || table->columns->empty()) {
+		return 0;
+	}
+	return table->columns->at(0).rows();
+}
+
+const char* bbi_table_model_name(const bbi_table *table) {
+	return (table != nullptr) ? table->reader.get_model_name().c_str() : nullptr;
+}
+
+const char* bbi_table_input_name(const bbi_table *table, int input) {
+
+	if (table == nullptr) {
+		return nullptr;
+	}
+
+	const std::vector<std::string> &names =
+			table->reader.get_truth_table().get_input_names();
+
+	if (input < 0 || input >= (int) names.size()) {
+		return nullptr;
+	}
+
+	return names[input].c_str();
+}
+
+const char* bbi_table_output_name(const bbi_table *table, int output) {
+
+	if (table == nullptr) {
+		return nullptr;
+	}
+
+	const std::vector<std::string> &names =
+			table->reader.get_truth_table().get_output_names();
+
+	if (output < 0 || output >= (int) names.size()) {
+		return nullptr;
+	}
+
+	return names[output].c_str();
+}
+
+int bbi_column_representation(const bbi_table *table, int output) {
+
+	if (!valid_output(table, output)) {
+		return -1;
+	}
+
+	return table->columns->at(output).get_representation();
+}
+
+const uint64_t* bbi_column_data(const bbi_table *table, int output,
+		uint64_t *length) {
+
+	if (!valid_output(table, output)) {
+		return nullptr;
+	}
+
+	const WordVector &data = table->columns->at(output).get_data();
+
+	if (length != nullptr) {
+		*length = data.size();
+	}
+
+	return data.data();
+}
+
+uint64_t bbi_column_count_ones(const bbi_table *table, int output) {
+
+	if (!valid_output(table, output)) {
+		return 0;
+	}
+
+	return table->columns->at(output).count_ones();
+}
+
+int bbi_column_get(const bbi_table *table, int output, uint64_t row) {
+
+	if (!valid_output(table, output)) {
+		return -1;
+	}
+
+	const OutputColumn &column = table->columns->at(output);
+
+	if (row >= column.rows()) {
+		set_error("Row index is out of range!");
+		return -1;
+	}
+
+	return column.get(row);
+}
+
+int bbi_table_has_care(const bbi_table *table) {
+	return (table != nullptr) ? !table->care_columns->empty() : -1;
+}
+
+int bbi_care_column_representation(const bbi_table *table, int output) {
+
+	if (!valid_care_output(table, output)) {
+		return -1;
+	}
+
+	return table->care_columns->at(output).get_representation();
+}
+
+const uint64_t* bbi_care_column_data(const bbi_table *table, int output,
+		uint64_t *length) {
+
+	if (!valid_care_output(table, output)) {
+		return nullptr;
+	}
+
+	const WordVector &data = table->care_columns->at(output).get_data();
+
+	if (length != nullptr) {
+		*length = data.size();
+	}
+
+	return data.data();
+}
+
+int bbi_care_column_get(const bbi_table *table, int output, uint64_t row) {
+
+	if (!valid_care_output(table, output)) {
+		return -1;
+	}
+
+	const OutputColumn &column = table->care_columns->at(output);
+
+	if (row >= column.rows()) {
+		set_error("Row index is out of range!");
+		return -1;
+	}
+
+	return column.get(row);
+}
+
+const uint64_t* bbi_input_column(const bbi_table *table, int input,
+		uint64_t *length) {
+
+	if (table == nullptr || input < 0
+			|| input >= table->reader.get_num_inputs()) {
+		set_error("Invalid table handle or input index!");
+		return nullptr;
+	}
+
+	try {
+		std::shared_ptr<const InputPatterns> patterns = InputPatternCache::get(
+				table->reader.get_num_inputs());
+
+		if (length != nullptr) {
+			*length = patterns->words();
+		}
+
+		return patterns->column(input);
+
+	} catch (const std::exception &e) {
+		set_error(e.what());
+		return nullptr;
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * Stable C ABI over the C++ benchmark reader.
+ *
+ * Tables are exposed as opaque handles. The packed output columns are returned
+ * as raw pointers into the buffers owned by the handle, so that foreign language
+ * bindings can wrap them without copying. The pointers stay valid until the handle
+ * is released with bbi_table_free().
+ *
+ * All functions returning a status code return BBI_OK on success. On failure, the
+ * message of the error can be retrieved with bbi_last_error().
+ */
+#ifndef BENCHMARK_C_API_H_
+#define BENCHMARK_C_API_H_
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define BBI_API __declspec(dllexport)
+#else
+#define BBI_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Version of the ABI, incremented on incompatible changes */
+#define BBI_ABI_VERSION 1
+
+/* Status codes */
+#define BBI_OK 0
+#define BBI_ERROR 1
+
+/* Column representations, see OutputColumn */
+#define BBI_DENSE 0
+#define BBI_SPARSE 1
+#define BBI_RLE 2
+
+/* Load flags */
+#define BBI_LOAD_DEFAULT 0
+#define BBI_LOAD_DENSE 1
+
+typedef struct bbi_table bbi_table;
+
+BBI_API int bbi_abi_version(void);
+BBI_API const char* bbi_last_error(void);
+
+BBI_API int bbi_table_load(const char *file_path, int flags,
+		bbi_table **table);
+BBI_API void bbi_table_free(bbi_table *table);
+
+BBI_API int bbi_table_num_inputs(const bbi_table *table);
+BBI_API int bbi_table_num_outputs(const bbi_table *table);
+BBI_API uint64_t bbi_table_num_rows(const bbi_table *table);
+BBI_API const char* bbi_table_model_name(const bbi_table *table);
+BBI_API const char* bbi_table_input_name(const bbi_table *table, int input);
+BBI_API const char* bbi_table_output_name(const bbi_table *table,
+		int output);
+
+BBI_API int bbi_column_representation(const bbi_table *table, int output);
+BBI_API const uint64_t* bbi_column_data(const bbi_table *table, int output,
+		uint64_t *length);
+BBI_API uint64_t bbi_column_count_ones(const bbi_table *table, int output);
+BBI_API int bbi_column_get(const bbi_table *table, int output, uint64_t row);
+
+/*
+ * Care masks of incompletely specified functions, in the same representations
+ * as the output columns. Bit r of the mask of an output is cleared if the output
+ * is a don't care in row r, where its column holds 0. bbi_table_has_care()
+ * returns 0 for completely specified functions, which have no masks.
+ */
+BBI_API int bbi_table_has_care(const bbi_table *table);
+BBI_API int bbi_care_column_representation(const bbi_table *table, int output);
+BBI_API const uint64_t* bbi_care_column_data(const bbi_table *table, int output,
+		uint64_t *length);
+BBI_API int bbi_care_column_get(const bbi_table *table, int output,
+		uint64_t row);
+
+/*
+ * Packed input columns, shared by all tables with the same number of inputs.
+ * The pointers stay valid for the lifetime of the process.
+ */
+BBI_API const uint64_t* bbi_input_column(const bbi_table *table, int input,
+		uint64_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_C_API_H_ */
@@ -0,0 +1,100 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Checks that the PLA, TT and PLU versions of benchmarks encode
+//               the same function.
+//
+//               Usage: check-equivalence <directory>
+//                      check-equivalence <file> <file>...
+//
+//               In a directory, the files with the same path apart from the
+//               extension are compared with each other. Otherwise, every file
+//               is compared with the first one. The exit status is 1 if any
+//               comparison fails.
+//============================================================================
+
+#include <iostream>
+#include <map>
+#include <chrono>
+
+#include "EquivalenceChecker.h"
+#include "BenchmarkCatalog.h"
+
+static bool check(const std::vector<std::string> &p_files) {
+
+	bool equivalent = true;
+	std::vector<EquivalenceResult> results;
+
+	try {
+		results = EquivalenceChecker::compare_files(p_files);
+	} catch (const std::exception &e) {
+		std::cout << "ERROR    " << p_files[0] << ": " << e.what() << std::endl;
+		return false;
+	}
+
+	for (size_t k = 0; k < results.size(); k++) {
+		if (results[k].equivalent) {
+			continue;
+		}
+
+		std::cout << "MISMATCH " << p_files[0] << " " << p_files[k + 1] << ": "
+				<< results[k].message << std::endl;
+		equivalent = false;
+	}
+
+	if (equivalent) {
+		std::cout << "OK       " << p_files[0];
+
+		for (size_t k = 1; k < p_files.size(); k++) {
+			std::cout << " " << p_files[k];
+		}
+
+		std::cout << std::endl;
+	}
+
+	return equivalent;
+}
+
+int main(int argc, char **argv) {
+
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <directory> | <file> <file>..."
+				<< std::endl;
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	bool equivalent = true;
+	int num_groups = 0;
+
+	if (argc == 2 && std::filesystem::is_directory(argv[1])) {
+		namespace fs = std::filesystem;
+
+		std::map<std::string, std::vector<std::string>> groups;
+
+		for (const fs::directory_entry &file : fs::recursive_directory_iterator(argv[1])) {
+			if (file.is_regular_file() && BenchmarkCatalog::file_format(file.path()) >= 0) {
+				fs::path stem = file.path();
+				groups[stem.replace_extension().string()].push_back(file.path().string());
+			}
+		}
+
+		for (auto &group : groups) {
+			if (group.second.size() > 1) {
+				std::sort(group.second.begin(), group.second.end());
+				equivalent = check(group.second) && equivalent;
+				num_groups++;
+			}
+		}
+	} else {
+		equivalent = check(std::vector<std::string>(argv + 1, argv + argc));
+		num_groups = 1;
+	}
+
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+
+	std::cerr << num_groups << " benchmarks checked in " << seconds << " s" << std::endl;
+
+	return equivalent ? 0 : 1;
+}
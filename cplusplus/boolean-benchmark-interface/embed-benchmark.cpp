@@ -0,0 +1,189 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Generates a header which embeds benchmark files as constexpr
+//               EmbeddedBenchmark instances.
+//
+//               Usage: embed-benchmark <header.h> <file.pla|file.tt|file.plu>...
+//
+//               Each benchmark is named after its model name, or after the
+//               file name if the file has no model name. The header also
+//               defines the array embedded_benchmarks with all benchmarks.
+//============================================================================
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <set>
+#include <cctype>
+
+#include "BenchmarkFileReader.h"
+#include "EmbeddedBenchmark.h"
+
+/*
+ * Returns a C++ identifier for the benchmark which is not used yet.
+ */
+static std::string identifier(std::string p_name, std::set<std::string> &p_used) {
+
+	for (char &c : p_name) {
+		if (!std::isalnum((unsigned char) c)) {
+			c = '_';
+		}
+	}
+
+	if (p_name.empty() || std::isdigit((unsigned char) p_name[0])) {
+		p_name = "b_" + p_name;
+	}
+
+	std::string name = p_name;
+
+	for (int k = 2; p_used.count(name) > 0; k++) {
+		name = p_name + "_" + std::to_string(k);
+	}
+
+	p_used.insert(name);
+	return name;
+}
+
+static std::string quote(const std::string &p_string) {
+
+	std::string s = "\"";
+
+	for (char c : p_string) {
+		if (c == '"' || c == '\\') {
+			s += '\\';
+		}
+		s += c;
+	}
+
+	return s + "\"";
+}
+
+static void write_words(std::ostream &p_os, const std::string &p_name,
+		const std::vector<OutputColumn> &p_columns) {
+
+	p_os << "inline constexpr uint64_t " << p_name << "[] = {";
+
+	uint64_t num_words = OutputColumn::num_words(p_columns.at(0).rows());
+	uint64_t k = 0;
+
+	for (const OutputColumn &column : p_columns) {
+		WordVector words;
+		column.to_words(words);
+
+		for (uint64_t w = 0; w < num_words; w++, k++) {
+			p_os << ((k % 4 == 0) ? "\n\t" : " ") << "0x" << std::hex
+					<< std::setw(16) << std::setfill('0') << words[w] << std::dec
+					<< "ULL,";
+		}
+	}
+
+	p_os << "\n};\n\n";
+}
+
+static void write_names(std::ostream &p_os, const std::string &p_name,
+		const std::vector<std::string> &p_names) {
+
+	p_os << "inline constexpr const char *" << p_name << "[] = {";
+
+	for (size_t k = 0; k < p_names.size(); k++) {
+		p_os << ((k % 8 == 0) ? "\n\t" : " ") << quote(p_names[k]) << ",";
+	}
+
+	p_os << "\n};\n\n";
+}
+
+int main(int argc, char **argv) {
+
+	if (argc < 3) {
+		std::cerr << "Usage: " << argv[0]
+				<< " <header.h> <file.pla|file.tt|file.plu>..." << std::endl;
+		return 1;
+	}
+
+	std::filesystem::path header_path = argv[1];
+	std::set<std::string> used;
+
+	std::string guard = identifier(header_path.filename().string(), used);
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+	std::stringstream body;
+	used.clear();
+	std::vector<std::string> benchmarks;
+
+	for (int a = 2; a < argc; a++) {
+		BenchmarkFileReader<int> reader;
+		reader.set_keep_rows(false);
+		reader.read_file(argv[a]);
+
+		const TruthTable<int> &table = reader.get_truth_table();
+		const std::vector<OutputColumn> &columns = table.get_output_columns();
+
+		if (columns.size() == 0) {
+			std::cerr << argv[a] << ": the file format has no packed columns" << std::endl;
+			return 1;
+		}
+
+		std::string model_name = table.get_model_name();
+		std::string name = identifier(model_name.length() > 0 ?
+				model_name : std::filesystem::path(argv[a]).stem().string(), used);
+
+		uint64_t num_rows = columns.at(0).rows();
+
+		body << "// " << std::filesystem::path(argv[a]).filename().string() << "\n\n";
+
+		write_words(body, name + "_words", columns);
+
+		if (table.has_care_columns()) {
+			write_words(body, name + "_care_words", table.get_care_columns());
+		}
+
+		if (table.get_input_names().size() > 0) {
+			write_names(body, name + "_input_names", table.get_input_names());
+		}
+
+		if (table.get_output_names().size() > 0) {
+			write_names(body, name + "_output_names", table.get_output_names());
+		}
+
+		body << "inline constexpr EmbeddedBenchmark " << name << " = {\n"
+				<< "\t" << quote(model_name) << ",\n"
+				<< "\t" << __builtin_ctzll(num_rows) << ", " << columns.size() << ", "
+				<< num_rows << "ULL, " << OutputColumn::num_words(num_rows) << "ULL,\n"
+				<< "\t" << name << "_words,\n"
+				<< "\t" << (table.has_care_columns() ? name + "_care_words" : "nullptr")
+				<< ",\n"
+				<< "\t" << (table.get_input_names().size() > 0 ?
+						name + "_input_names" : "nullptr") << ",\n"
+				<< "\t" << (table.get_output_names().size() > 0 ?
+						name + "_output_names" : "nullptr") << "\n"
+				<< "};\n\n";
+
+		benchmarks.push_back(name);
+	}
+
+	std::ofstream ofs(header_path);
+
+	if (!ofs.is_open()) {
+		std::cerr << "Cannot open " << header_path << std::endl;
+		return 1;
+	}
+
+	ofs << "// Generated by embed-benchmark, do not edit.\n\n"
+			<< "#ifndef " << guard << "_\n"
+			<< "#define " << guard << "_\n\n"
+			<< "#include <cstdint>\n\n"
+			<< "#include \"EmbeddedBenchmark.h\"\n\n"
+			<< body.str()
+			<< "inline constexpr const EmbeddedBenchmark *embedded_benchmarks[] = {";
+
+	for (const std::string &name : benchmarks) {
+		ofs << "\n\t&" << name << ",";
+	}
+
+	ofs << "\n};\n\n"
+			<< "#endif /* " << guard << "_ */\n";
+
+	return ofs.good() ? 0 : 1;
+}
@@ -0,0 +1,379 @@
+//============================================================================
+// Project     : General Boolean Function Benchmark Suite
+// Description : Instantiates the headers which no other program includes and
+//               checks them on small generated functions.
+//
+//               Usage: self-check
+//
+//               Every check compares a result with an independent computation
+//               on the packed output columns, e.g. the expansion of an ISOP
+//               cover with the table it was extracted from. Prints one line per
+//               check, the exit status is 1 if any check fails.
+//============================================================================
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "BenchmarkGenerator.h"
+#include "BlockedEvaluator.h"
+#include "EditableCover.h"
+#include "FitnessCache.h"
+#include "FunctionAnalysis.h"
+#include "FunctionView.h"
+#include "Isop.h"
+#include "ParallelFor.h"
+#include "SharedTable.h"
+#include "WalshSpectrum.h"
+
+static int failures = 0;
+
+static void check(const std::string &p_name, bool p_passed) {
+	std::cout << (p_passed ? "ok       " : "FAILED   ") << p_name << std::endl;
+	failures += p_passed ? 0 : 1;
+}
+
+/*
+ * Compares the packed output columns of a table with dense bit vectors.
+ */
+template<class T>
+static bool same_columns(const TruthTable<T> &p_table,
+		const std::vector<WordVector> &p_words) {
+
+	if ((int) p_words.size() != p_table.num_output_columns()) {
+		return false;
+	}
+
+	WordVector words;
+
+	for (int j = 0; j < p_table.num_output_columns(); j++) {
+		p_table.get_output_column(j).to_words(words);
+
+		if (words != p_words[j]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Fills a dense candidate for each output of the table with pseudo-random words.
+ */
+template<class T>
+static std::vector<uint64_t> random_candidate(const TruthTable<T> &p_table,
+		uint64_t p_seed) {
+
+	uint64_t num_words = OutputColumn::num_words(p_table.get_output_column(0).rows());
+	std::vector<uint64_t> candidate(p_table.num_output_columns() * num_words);
+
+	for (uint64_t &word : candidate) {
+		p_seed = p_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		word = p_seed;
+	}
+
+	return candidate;
+}
+
+static void check_parallel_for() {
+
+	std::vector<uint64_t> squares(1000);
+
+	parallel_for(squares.size(), 4, [&](uint64_t p_index, int) {
+		squares[p_index] = p_index * p_index;
+	});
+
+	bool passed = true;
+
+	for (uint64_t i = 0; i < squares.size(); i++) {
+		passed = passed && (squares[i] == i * i);
+	}
+
+	check("parallel_for visits every index", passed);
+
+	try {
+		parallel_for(100, 4, [](uint64_t p_index, int) {
+			if (p_index == 42) {
+				throw std::runtime_error("42");
+			}
+		});
+		check("parallel_for rethrows exceptions", false);
+	} catch (const std::runtime_error &e) {
+		check("parallel_for rethrows exceptions", std::string(e.what()) == "42");
+	}
+}
+
+static void check_function_view() {
+
+	TruthTable<int> table = BenchmarkGenerator::parity<int>(6);
+	FunctionView view(table.get_output_column(0));
+
+	// Fixing an input of a parity function leaves a parity function of the others
+	FunctionView cofactor = view.cofactor(0, true);
+	check("FunctionView cofactor", cofactor.inputs() == 5 && cofactor.count_ones() == 16
+			&& cofactor.get(0) == 1 && cofactor.get(1) == 0);
+
+	std::vector<int> reverse = { 5, 4, 3, 2, 1, 0 };
+	WordVector words;
+	view.permute(reverse).materialize(words);
+	check("FunctionView permute", same_columns(table, { words }));
+
+	// The cofactor of a multiplexer on its select input is the selected data input
+	TruthTable<int> mux = BenchmarkGenerator::multiplexer<int>(1);
+	FunctionView selected = FunctionView(mux.get_output_column(0)).cofactor(0, false);
+	bool passed = (selected.inputs() == 2);
+
+	for (uint64_t r = 0; r < selected.rows() && passed; r++) {
+		passed = (selected.get(r) == (((r >> 1) & 1) != 0));
+	}
+
+	check("FunctionView multiplexer cofactor", passed);
+}
+
+static void check_function_analysis() {
+
+	TruthTable<int> parity = BenchmarkGenerator::parity<int>(6);
+	BenchmarkSummary summary = FunctionAnalysis::analyze(parity, 2);
+	const OutputSummary &output = summary.outputs.at(0);
+
+	check("FunctionAnalysis of parity", output.balanced && output.ones == 32
+			&& output.support_mask == 0x3F && output.symmetric_pairs.size() == 15
+			&& !summary.is_unate(0));
+
+	// The select input of a multiplexer is binate, the data inputs positive unate
+	TruthTable<int> mux = BenchmarkGenerator::multiplexer<int>(1);
+	BenchmarkSummary mux_summary = FunctionAnalysis::analyze(mux, 1);
+	const OutputSummary &selected = mux_summary.outputs.at(0);
+
+	check("FunctionAnalysis of a multiplexer", selected.support_mask == 0x7
+			&& selected.positive_unate_mask == 0x6 && selected.negative_unate_mask == 0
+			&& selected.symmetric_pairs.empty());
+}
+
+static void check_walsh_spectrum() {
+
+	TruthTable<int> parity = BenchmarkGenerator::parity<int>(8);
+	check("WalshSpectrum of parity", WalshSpectrum::analyze(parity, 2).at(0).nonlinearity == 0);
+
+	// Parseval: the squared coefficients sum up to the square of the number of rows
+	TruthTable<int> table = BenchmarkGenerator::random<int>(10, 1, 7);
+	const OutputColumn &column = table.get_output_column(0);
+
+	std::vector<int64_t> spectrum;
+	WalshSpectrum::spectrum(column, spectrum);
+
+	int64_t sum = 0;
+
+	for (int64_t coefficient : spectrum) {
+		sum += coefficient * coefficient;
+	}
+
+	check("WalshSpectrum Parseval identity", sum == (int64_t(1) << 20));
+
+	// The absolute indicator by its definition over all nonzero shifts
+	int64_t indicator = 0;
+
+	for (uint64_t d = 1; d < column.rows(); d++) {
+		int64_t r = 0;
+
+		for (uint64_t x = 0; x < column.rows(); x++) {
+			r += (column.get(x) == column.get(x ^ d)) ? 1 : -1;
+		}
+
+		indicator = std::max<int64_t>(indicator, std::llabs(r));
+	}
+
+	check("WalshSpectrum absolute indicator",
+			WalshSpectrum::summarize_output(column).absolute_indicator == indicator);
+}
+
+static void check_blocked_evaluator() {
+
+	TruthTable<int> table = BenchmarkGenerator::multiplier<int>(5);
+	std::vector<uint64_t> candidate = random_candidate(table, 3);
+
+	int m = table.num_output_columns();
+	uint64_t num_words = OutputColumn::num_words(table.get_output_column(0).rows());
+
+	std::vector<uint64_t> expected(m);
+
+	for (int j = 0; j < m; j++) {
+		expected[j] = table.count_errors(j, candidate.data() + j * num_words);
+	}
+
+	// Small blocks, so that the blocks are shared among both threads
+	BlockedEvaluator evaluator(table, 4);
+	std::vector<uint64_t> errors(m);
+
+	evaluator.count_errors(candidate.data(), errors.data(), 2);
+	check("BlockedEvaluator count_errors", errors == expected);
+
+	evaluator.evaluate([&](uint64_t p_begin, uint64_t p_count, uint64_t *p_tile) {
+		for (int j = 0; j < m; j++) {
+			std::copy_n(&candidate[j * num_words + p_begin], p_count,
+					p_tile + j * evaluator.block_words());
+		}
+	}, errors.data(), 2);
+
+	check("BlockedEvaluator evaluate", errors == expected);
+
+	// The L1 minimum holds even if the L2 budget is below one word per output
+	uint64_t words = BlockedEvaluator::default_block_words(1 << 20, true);
+	check("BlockedEvaluator minimum block size", words >= 8 && (words & (words - 1)) == 0);
+}
+
+static void check_fitness_cache() {
+
+	TruthTable<int> table = BenchmarkGenerator::multiplier<int>(5);
+	std::vector<uint64_t> candidate = random_candidate(table, 3);
+
+	int m = table.num_output_columns();
+	uint64_t num_words = OutputColumn::num_words(table.get_output_column(0).rows());
+
+	std::vector<uint64_t> expected(m);
+
+	for (int j = 0; j < m; j++) {
+		expected[j] = table.count_errors(j, candidate.data() + j * num_words);
+	}
+
+	std::vector<uint64_t> errors(m);
+	FitnessCache cache(m, table.get_output_column(0).rows(), 16);
+
+	bool miss = !cache.evaluate(table, candidate.data(), errors.data());
+	bool hit = cache.evaluate(table, candidate.data(), errors.data());
+	check("FitnessCache miss and hit", miss && hit && errors == expected);
+
+	// The unused bits after the last row don't change the signature
+	FitnessCache small(1, 40, 4);
+	uint64_t word = 0x12345678ULL;
+	uint64_t dirty = word | (uint64_t(0xFF) << 48);
+
+	check("FitnessCache ignores unused bits", small.hash(&word) == small.hash(&dirty)
+			&& !(small.hash(&word) == small.hash(&candidate[0])));
+}
+
+static void check_shared_table() {
+
+	TruthTable<int> table = BenchmarkGenerator::multiplier<int>(4);
+	std::vector<uint64_t> candidate = random_candidate(table, 5);
+	uint64_t num_words = OutputColumn::num_words(table.get_output_column(0).rows());
+
+	std::string name = "/bbi-self-check-" + std::to_string(getpid());
+
+	try {
+		SharedTable::publish(name, table);
+
+		SharedTable shared(name);
+		bool passed = (shared.outputs() == table.num_output_columns());
+
+		for (int j = 0; j < shared.outputs() && passed; j++) {
+			passed = (shared.count_errors(j, candidate.data() + j * num_words)
+					== table.count_errors(j, candidate.data() + j * num_words));
+		}
+
+		check("SharedTable count_errors", passed);
+
+		TruthTable<int> loaded;
+		shared.load(loaded);
+
+		std::vector<WordVector> words(table.num_output_columns());
+
+		for (int j = 0; j < table.num_output_columns(); j++) {
+			table.get_output_column(j).to_words(words[j]);
+		}
+
+		check("SharedTable load", same_columns(loaded, words));
+		SharedTable::remove(name);
+
+	} catch (const std::exception &e) {
+		SharedTable::remove(name);
+		check(std::string("SharedTable: ") + e.what(), false);
+	}
+}
+
+static void check_isop() {
+
+	TruthTable<int> table = BenchmarkGenerator::adder<int>(3);
+	Cover cover = Isop::extract(table, 2);
+
+	std::vector<WordVector> words;
+	cover.expand(words);
+	check("Isop cover expands to the table", same_columns(table, words));
+
+	// A cube which is contained in another one is not irredundant
+	bool irredundant = true;
+
+	for (const Cube &a : cover.get_cubes()) {
+		for (const Cube &b : cover.get_cubes()) {
+			if (&a != &b && (a.care & b.care) == b.care
+					&& (a.value & b.care) == b.value && a.outputs == b.outputs) {
+				irredundant = false;
+			}
+		}
+	}
+
+	check("Isop cover has no contained cubes", irredundant);
+}
+
+static void check_editable_cover() {
+
+	TruthTable<int> table = BenchmarkGenerator::adder<int>(3);
+	EditableCover editable(Isop::extract(table, 1));
+
+	bool passed = true;
+
+	for (int j = 0; j < table.num_output_columns(); j++) {
+		passed = passed && (editable.count_errors(table, j) == 0);
+	}
+
+	int index = editable.add_cube(std::string(6, '-'), std::string(4, '1'));
+	const OutputColumn &sum = table.get_output_column(0);
+
+	passed = passed && (editable.count_ones(0) == editable.rows())
+			&& (editable.count_errors(table, 0) == sum.rows() - sum.count_ones());
+
+	editable.remove_cube(index);
+
+	std::vector<WordVector> words;
+	editable.get_cover().expand(words);
+
+	TruthTable<int> applied = table;
+	editable.apply(applied);
+
+	check("EditableCover add and remove", passed && editable.count_errors(table, 0) == 0
+			&& same_columns(applied, words));
+
+	// Bits above the inputs or values outside the care mask address other rows
+	int rejected = 0;
+
+	for (uint64_t value : { uint64_t(0x30), uint64_t(0x1) }) {
+		Cube cube;
+		cube.value = value;
+		cube.care = 0x30 & value;
+		cube.outputs.assign(1, 1);
+
+		try {
+			EditableCover(4, 1).add_cube(cube);
+		} catch (const std::runtime_error&) {
+			rejected++;
+		}
+	}
+
+	check("EditableCover rejects invalid cubes", rejected == 2);
+}
+
+int main() {
+
+	check_parallel_for();
+	check_function_view();
+	check_function_analysis();
+	check_walsh_spectrum();
+	check_blocked_evaluator();
+	check_fitness_cache();
+	check_shared_table();
+	check_isop();
+	check_editable_cover();
+
+	return (failures > 0) ? 1 : 0;
+}
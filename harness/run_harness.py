@@ -0,0 +1,253 @@
+"""
+Cross-language throughput harness for the C++, Java and Python interfaces.
+
+A fixed corpus of TT and PLA files is generated with a constant seed, and
+every file is read by the timing driver of each interface in a separate
+process. The drivers report the seconds spent on the header, the body and
+the expansion of the table as well as the peak resident set size of their
+process. The harness prints all results side by side.
+
+Interfaces whose toolchain is not available are skipped.
+
+Usage: python3 harness/run_harness.py [--corpus DIR] [--max-inputs N] [--repeat R]
+"""
+
+import argparse
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+from os import path
+
+ROOT = path.dirname(path.dirname(path.abspath(__file__)))
+CPP_DIR = path.join(ROOT, 'cplusplus', 'boolean-benchmark-interface')
+JAVA_DIR = path.join(ROOT, 'java', 'boolean-benchmark-interface')
+PYTHON_DIR = path.join(ROOT, 'python', 'boolean-benchmark-interface')
+
+# Arities of the generated corpus, each as TT and PLA file
+CORPUS_INPUTS = [8, 12, 16, 20]
+CORPUS_OUTPUTS = 8
+CORPUS_CUBES = 64
+CORPUS_SEED = 42
+
+
+def write_header(f, name: str, num_inputs: int, num_outputs: int, num_cubes: int = -1) -> None:
+    """
+    Writes the header of a benchmark file.
+
+    :param f: File object
+    :param name: Model name
+    :param num_inputs: Number of inputs
+    :param num_outputs: Number of outputs
+    :param num_cubes: Number of product terms, omitted when negative
+    :return: None
+    """
+    f.write(".model %s\n.i %d\n.o %d\n" % (name, num_inputs, num_outputs))
+
+    if num_cubes >= 0:
+        f.write(".p %d\n" % num_cubes)
+
+    f.write(".ilb " + " ".join("x%d" % i for i in range(num_inputs)) + "\n")
+    f.write(".ob " + " ".join("y%d" % i for i in range(num_outputs)) + "\n")
+
+
+def write_tt(file_path: str, num_inputs: int, rng: random.Random) -> None:
+    """
+    Writes a random completely specified function as TT file.
+
+    :param file_path: Path of the TT file
+    :param num_inputs: Number of inputs
+    :param rng: Random number generator
+    :return: None
+    """
+    name = path.splitext(path.basename(file_path))[0]
+    row_format = '{:0%db} ' % num_inputs
+
+    with open(file_path, 'w') as f:
+        write_header(f, name, num_inputs, CORPUS_OUTPUTS)
+
+        for row in range(1 << num_inputs):
+            outputs = format(rng.getrandbits(CORPUS_OUTPUTS), '0%db' % CORPUS_OUTPUTS)
+            f.write(row_format.format(row) + outputs + "\n")
+
+        f.write(".end\n")
+
+
+def write_pla(file_path: str, num_inputs: int, rng: random.Random) -> None:
+    """
+    Writes a random cover with one output per cube as PLA file.
+
+    :param file_path: Path of the PLA file
+    :param num_inputs: Number of inputs
+    :param rng: Random number generator
+    :return: None
+    """
+    name = path.splitext(path.basename(file_path))[0]
+
+    with open(file_path, 'w') as f:
+        write_header(f, name, num_inputs, CORPUS_OUTPUTS, CORPUS_CUBES)
+
+        for _ in range(CORPUS_CUBES):
+            cube = "".join(rng.choice('01--') for _ in range(num_inputs))
+            output = rng.randrange(CORPUS_OUTPUTS)
+            f.write(cube + " " + "".join('1' if j == output else '0' for j in range(CORPUS_OUTPUTS)) + "\n")
+
+        f.write(".e\n")
+
+
+def generate_corpus(directory: str, max_inputs: int) -> list:
+    """
+    Generates the corpus, unless a file of it already exists.
+
+    :param directory: Target directory
+    :param max_inputs: Largest arity of the corpus
+    :return: List of file paths
+    """
+    os.makedirs(directory, exist_ok=True)
+    files = []
+
+    for num_inputs in CORPUS_INPUTS:
+        if num_inputs > max_inputs:
+            continue
+
+        # Each file has its own seed, so the corpus does not depend on max_inputs
+        for extension, writer in (('.tt', write_tt), ('.pla', write_pla)):
+            file_path = path.join(directory, 'random%d%s' % (num_inputs, extension))
+
+            if not path.exists(file_path):
+                writer(file_path, num_inputs, random.Random(CORPUS_SEED * 100 + num_inputs))
+
+            files.append(file_path)
+
+    return files
+
+
+def build_interfaces(build_dir: str) -> list:
+    """
+    Builds the timing drivers and returns the available interfaces.
+
+    :param build_dir: Directory for the compiled Java classes
+    :return: List of (name, command, working directory) tuples
+    """
+    interfaces = []
+
+    if shutil.which('make') and shutil.which(os.environ.get('CXX', 'g++')):
+        subprocess.run(['make', '-s', 'bench-reader', 'libbenchmark-interface.so'], cwd=CPP_DIR, check=True)
+        interfaces.append(("C++", [path.join(CPP_DIR, 'bench-reader')], CPP_DIR))
+    else:
+        print("Skipping C++: make or compiler not found")
+
+    if shutil.which('javac') and shutil.which('java'):
+        sources = ['BenchmarkFileReader.java', 'TruthTable.java', 'Minterm.java', 'BenchmarkHarness.java']
+        subprocess.run(['javac', '-nowarn', '-d', build_dir] + sources, cwd=JAVA_DIR, check=True)
+        interfaces.append(("Java", ['java', '-cp', build_dir, 'BenchmarkHarness'], JAVA_DIR))
+    else:
+        print("Skipping Java: javac or java not found")
+
+    interfaces.append(("Python", [sys.executable, 'bench_reader.py'], PYTHON_DIR))
+
+    if path.exists(path.join(CPP_DIR, 'libbenchmark-interface.so')):
+        interfaces.append(("Python (C ABI)", [sys.executable, 'bench_reader.py', '--native'], PYTHON_DIR))
+
+    return interfaces
+
+
+def run_interface(command: list, cwd: str, file_path: str, repeat: int):
+    """
+    Runs a timing driver repeatedly and keeps the fastest run.
+
+    :return: Best result or a status string
+    """
+    best = None
+
+    for _ in range(repeat):
+        result = run_driver(command, cwd, file_path)
+
+        if not isinstance(result, dict):
+            return result
+
+        if best is None or result['body'] + result['expand'] < best['body'] + best['expand']:
+            best = result
+
+    return best
+
+
+def run_driver(command: list, cwd: str, file_path: str):
+    """
+    Runs a timing driver and parses its RESULT line.
+
+    :param command: Command of the driver
+    :param cwd: Working directory
+    :param file_path: Benchmark file passed to the driver
+    :return: Dictionary with the timings and the peak RSS in KiB, or a status string
+    """
+    process = subprocess.run(command + [file_path], cwd=cwd, stdout=subprocess.PIPE,
+                             stderr=subprocess.DEVNULL, universal_newlines=True)
+
+    if process.returncode != 0:
+        return "failed"
+
+    for line in process.stdout.splitlines():
+        if line.startswith("RESULT"):
+            result = dict(item.split('=') for item in line.split()[1:])
+            return {key: float(value) for key, value in result.items()}
+
+        if line.startswith("UNSUPPORTED"):
+            return "unsupported"
+
+    return "failed"
+
+
+def print_results(results: list) -> None:
+    """
+    Prints the results as table.
+
+    :param results: List of (file, interface, result) tuples
+    :return: None
+    """
+    header = ("File", "Interface", "Rows", "Header ms", "Body ms", "Expand ms", "Rows/s", "Peak RSS MiB")
+    row_format = "{:<16} {:<16} {:>9} {:>10} {:>10} {:>10} {:>12} {:>13}"
+
+    print(row_format.format(*header))
+    print("-" * 103)
+
+    for file_name, interface, result in results:
+        if not isinstance(result, dict):
+            print(row_format.format(file_name, interface, result, "", "", "", "", ""))
+            continue
+
+        total = result['body'] + result['expand']
+        rate = result['rows'] / total if total > 0 else float('inf')
+
+        print(row_format.format(file_name, interface, int(result['rows']),
+                                "%.2f" % (result['header'] * 1e3), "%.2f" % (result['body'] * 1e3),
+                                "%.2f" % (result['expand'] * 1e3), "%.0f" % rate,
+                                "%.1f" % (result.get('rss', 0) / 1024.0)))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Cross-language throughput harness")
+    parser.add_argument('--corpus', default=path.join(tempfile.gettempdir(), 'boolean-benchmark-corpus'),
+                        help="Directory of the generated corpus")
+    parser.add_argument('--max-inputs', type=int, default=16, help="Largest arity of the corpus")
+    parser.add_argument('--repeat', type=int, default=3, help="Runs per file and interface, the fastest is kept")
+    args = parser.parse_args()
+
+    files = generate_corpus(args.corpus, args.max_inputs)
+    results = []
+
+    with tempfile.TemporaryDirectory() as build_dir:
+        interfaces = build_interfaces(build_dir)
+
+        for file_path in files:
+            for name, command, cwd in interfaces:
+                result = run_interface(command, cwd, file_path, args.repeat)
+                results.append((path.basename(file_path), name, result))
+
+    print_results(results)
+
+
+if __name__ == '__main__':
+    main()
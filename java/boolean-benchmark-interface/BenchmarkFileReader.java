@@ -267,7 +267,7 @@ public class BenchmarkFileReader {
 	 * 
 	 * @param filePath
 	 */
-	private void openFile(String filePath) {
+	public void openFile(String filePath) {
 
 		try {
 			File file = new File(filePath);
@@ -281,7 +281,7 @@ public class BenchmarkFileReader {
 	/**
 	 * 
 	 */
-	private void closeFile() {
+	public void closeFile() {
 		try {
 			this.randomAccessFile.close();
 		} catch (IOException e) {
@@ -0,0 +1,81 @@
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.text.ParseException;
+
+/**
+ * Timing driver of the Java interface for the cross-language throughput harness
+ * (harness/run_harness.py).
+ * 
+ * Usage: java BenchmarkHarness &lt;file.tt|file.pla&gt;
+ * 
+ * Prints one RESULT line with the seconds spent on reading the header and the
+ * body, followed by the peak resident set size of the process in KiB. The Java
+ * reader stores the rows directly, so there is no separate expansion step.
+ * 
+ * @version 1.0
+ */
+public class BenchmarkHarness {
+
+	/**
+	 * Returns the seconds elapsed since the given start time.
+	 * 
+	 * @param start start time in nanoseconds
+	 * @return elapsed seconds
+	 */
+	private static double secondsSince(long start) {
+		return (System.nanoTime() - start) / 1e9;
+	}
+
+	/**
+	 * Returns the peak resident set size of the process in KiB (VmHWM).
+	 * 
+	 * @return peak RSS or 0 if /proc is not available
+	 */
+	private static long peakRss() {
+		try {
+			for (String line : Files.readAllLines(Paths.get("/proc/self/status"))) {
+				if (line.startsWith("VmHWM:")) {
+					return Long.parseLong(line.substring(6).trim().split("\\s+")[0]);
+				}
+			}
+		} catch (IOException e) {
+			e.printStackTrace();
+		}
+		return 0;
+	}
+
+	public static void main(String[] args) throws IOException, ParseException {
+
+		if (args.length < 1) {
+			System.err.println("Usage: java BenchmarkHarness <file.tt|file.pla>");
+			System.exit(1);
+		}
+
+		String filePath = args[0];
+
+		if (!filePath.toLowerCase().endsWith(".tt")) {
+			System.out.println("UNSUPPORTED");
+			return;
+		}
+
+		BenchmarkFileReader reader = new BenchmarkFileReader();
+
+		long start = System.nanoTime();
+
+		reader.openFile(filePath);
+		reader.readHeader();
+
+		double header = secondsSince(start);
+		start = System.nanoTime();
+
+		reader.readTTFile(filePath);
+
+		double body = secondsSince(start);
+
+		reader.closeFile();
+
+		System.out.println("RESULT header=" + header + " body=" + body + " expand=0 rows="
+				+ reader.getTable().rows() + " rss=" + peakRss());
+	}
+}
@@ -0,0 +1,521 @@
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.FunctionDescriptor;
+import java.lang.foreign.Linker;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.SymbolLookup;
+import java.lang.foreign.ValueLayout;
+import java.lang.invoke.MethodHandle;
+import java.nio.file.Path;
+import java.util.Vector;
+
+/**
+ * Reads benchmark files through the C ABI of the C++ reader by using the
+ * foreign function and memory API (Java 22 or newer). The packed output
+ * columns are returned as read-only memory segments which point directly into
+ * the buffers of the native table, so no data is copied.
+ *
+ * Incompletely specified functions (PLA types fd, fr and fdr) additionally have
+ * a care mask per output, see hasCare, getCareColumn and isCare.
+ *
+ * The segments belong to a shared arena of the current table, which is closed
+ * when the reader is closed or the next file is read. Accessing a segment of a
+ * released table throws an IllegalStateException instead of reading freed memory.
+ * The JVM has to be started with --enable-native-access=ALL-UNNAMED to avoid
+ * warnings about the restricted methods that are used.
+ *
+ * @version 1.0
+ *
+ * @see benchmark_c_api.h
+ */
+public class NativeBenchmarkReader implements AutoCloseable {
+
+	// Constants for the representation of an output column
+	public static final int DENSE = 0;
+	public static final int SPARSE = 1;
+	public static final int RLE = 2;
+
+	// Load flags of the C ABI
+	public static final int LOAD_DEFAULT = 0;
+	public static final int LOAD_DENSE = 1;
+
+	private static final Linker LINKER = Linker.nativeLinker();
+
+	private final SymbolLookup lookup;
+
+	private final MethodHandle lastError;
+	private final MethodHandle tableLoad;
+	private final MethodHandle tableFree;
+	private final MethodHandle tableNumInputs;
+	private final MethodHandle tableNumOutputs;
+	private final MethodHandle tableNumRows;
+	private final MethodHandle tableModelName;
+	private final MethodHandle tableInputName;
+	private final MethodHandle tableOutputName;
+	private final MethodHandle columnRepresentation;
+	private final MethodHandle columnData;
+	private final MethodHandle columnCountOnes;
+	private final MethodHandle columnGet;
+	private final MethodHandle tableHasCare;
+	private final MethodHandle careColumnRepresentation;
+	private final MethodHandle careColumnData;
+	private final MethodHandle careColumnGet;
+	private final MethodHandle inputColumn;
+
+	private MemorySegment table = MemorySegment.NULL;
+
+	// Scope of the segments of the current table, closed before the table is freed
+	private Arena arena = null;
+
+	/**
+	 * Loads the shared library and creates the downcall handles of the C ABI.
+	 *
+	 * @param libraryPath path of libbenchmark-interface.so
+	 */
+	public NativeBenchmarkReader(String libraryPath) {
+
+		this.lookup = SymbolLookup.libraryLookup(Path.of(libraryPath), Arena.global());
+
+		this.lastError = downcall("bbi_last_error", FunctionDescriptor.of(ValueLayout.ADDRESS));
+		this.tableLoad = downcall("bbi_table_load", FunctionDescriptor.of(ValueLayout.JAVA_INT,
+				ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+		this.tableFree = downcall("bbi_table_free", FunctionDescriptor.ofVoid(ValueLayout.ADDRESS));
+		this.tableNumInputs = downcall("bbi_table_num_inputs",
+				FunctionDescriptor.of(ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+		this.tableNumOutputs = downcall("bbi_table_num_outputs",
+				FunctionDescriptor.of(ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+		this.tableNumRows = downcall("bbi_table_num_rows",
+				FunctionDescriptor.of(ValueLayout.JAVA_LONG, ValueLayout.ADDRESS));
+		this.tableModelName = downcall("bbi_table_model_name",
+				FunctionDescriptor.of(ValueLayout.ADDRESS, ValueLayout.ADDRESS));
+		this.tableInputName = downcall("bbi_table_input_name",
+				FunctionDescriptor.of(ValueLayout.ADDRESS, ValueLayout.ADDRESS, ValueLayout.JAVA_INT));
+		this.tableOutputName = downcall("bbi_table_output_name",
+				FunctionDescriptor.of(ValueLayout.ADDRESS, ValueLayout.ADDRESS, ValueLayout.JAVA_INT));
+		this.columnRepresentation = downcall("bbi_column_representation",
+				FunctionDescriptor.of(ValueLayout.JAVA_INT, ValueLayout.ADDRESS, ValueLayout.JAVA_INT));
+		this.columnData = downcall("bbi_column_data", FunctionDescriptor.of(ValueLayout.ADDRESS,
+				ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+		this.columnCountOnes = downcall("bbi_column_count_ones",
+				FunctionDescriptor.of(ValueLayout.JAVA_LONG, ValueLayout.ADDRESS, ValueLayout.JAVA_INT));
+		this.columnGet = downcall("bbi_column_get", FunctionDescriptor.of(ValueLayout.JAVA_INT,
+				ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_LONG));
+		this.tableHasCare = downcall("bbi_table_has_care",
+				FunctionDescriptor.of(ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+		this.careColumnRepresentation = downcall("bbi_care_column_representation",
+				FunctionDescriptor.of(ValueLayout.JAVA_INT, ValueLayout.ADDRESS, ValueLayout.JAVA_INT));
+		this.careColumnData = downcall("bbi_care_column_data", FunctionDescriptor.of(ValueLayout.ADDRESS,
+				ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+		this.careColumnGet = downcall("bbi_care_column_get", FunctionDescriptor.of(ValueLayout.JAVA_INT,
+				ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.JAVA_LONG));
+		this.inputColumn = downcall("bbi_input_column", FunctionDescriptor.of(ValueLayout.ADDRESS,
+				ValueLayout.ADDRESS, ValueLayout.JAVA_INT, ValueLayout.ADDRESS));
+	}
+
+	/**
+	 * Creates a downcall handle for a symbol of the shared library.
+	 *
+	 * @param name       name of the C function
+	 * @param descriptor signature of the C function
+	 * @return method handle of the function
+	 */
+	private MethodHandle downcall(String name, FunctionDescriptor descriptor) {
+		MemorySegment symbol = this.lookup.find(name)
+				.orElseThrow(() -> new RuntimeException("Symbol not found: " + name));
+		return LINKER.downcallHandle(symbol, descriptor);
+	}
+
+	/**
+	 * Converts a NUL-terminated C string into a Java string.
+	 *
+	 * @param address address of the C string
+	 * @return string or null for a NULL pointer
+	 */
+	private static String toString(MemorySegment address) {
+		if (address.equals(MemorySegment.NULL)) {
+			return null;
+		}
+		return address.reinterpret(Long.MAX_VALUE).getString(0);
+	}
+
+	/**
+	 * Returns the message of the last error of the C ABI.
+	 *
+	 * @return error message
+	 */
+	private String lastError() {
+		try {
+			return toString((MemorySegment) this.lastError.invokeExact());
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Scopes a native buffer of the current table to its arena.
+	 *
+	 * @param data   address of the buffer
+	 * @param length number of 64 bit words
+	 * @return read-only segment which is invalidated when the table is released
+	 */
+	private MemorySegment segment(MemorySegment data, long length) {
+		return data.reinterpret(length * Long.BYTES, this.arena, null).asReadOnly();
+	}
+
+	/**
+	 * Validates the state of the table and the given output index.
+	 *
+	 * @param output index of the output
+	 */
+	private void validateOutput(int output) {
+		if (this.table.equals(MemorySegment.NULL)) {
+			throw new IllegalStateException("No benchmark file has been read!");
+		}
+		if (output < 0 || output >= this.getOutputs()) {
+			throw new IndexOutOfBoundsException("Output index is out of range!");
+		}
+	}
+
+	/**
+	 * Validates the output index and that the table has care masks.
+	 *
+	 * @param output index of the output
+	 */
+	private void validateCareOutput(int output) {
+		this.validateOutput(output);
+		if (!this.hasCare()) {
+			throw new IllegalStateException("Table has no don't care rows!");
+		}
+	}
+
+	/**
+	 * Reads a TT, PLA or PLU benchmark file with the C++ reader. A previously read
+	 * table is released.
+	 *
+	 * @param filePath path of the benchmark file
+	 * @param dense    repack compressed columns as dense bit vectors
+	 *
+	 * @throws IOException Exception is thrown when the file can't be read.
+	 */
+	public void readFile(String filePath, boolean dense) throws IOException {
+
+		this.close();
+
+		try (Arena arena = Arena.ofConfined()) {
+			MemorySegment path = arena.allocateFrom(filePath);
+			MemorySegment handle = arena.allocate(ValueLayout.ADDRESS);
+
+			int status = (int) this.tableLoad.invokeExact(path, dense ? LOAD_DENSE : LOAD_DEFAULT, handle);
+
+			if (status != 0) {
+				throw new IOException(this.lastError());
+			}
+
+			this.table = handle.get(ValueLayout.ADDRESS, 0);
+			this.arena = Arena.ofShared();
+		} catch (IOException e) {
+			throw e;
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the number of inputs.
+	 *
+	 * @return number of inputs.
+	 */
+	public int getInputs() {
+		try {
+			return (int) this.tableNumInputs.invokeExact(this.table);
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the number of outputs.
+	 *
+	 * @return number of outputs.
+	 */
+	public int getOutputs() {
+		try {
+			return (int) this.tableNumOutputs.invokeExact(this.table);
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the number of rows of the table.
+	 *
+	 * @return number of rows.
+	 */
+	public long getRows() {
+		try {
+			return (long) this.tableNumRows.invokeExact(this.table);
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the model name of the benchmark.
+	 *
+	 * @return model name
+	 */
+	public String getModelName() {
+		try {
+			return toString((MemorySegment) this.tableModelName.invokeExact(this.table));
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Collects the names returned by the given name function of the C ABI.
+	 *
+	 * @param nameFunction downcall handle of bbi_table_input_name or
+	 *                     bbi_table_output_name
+	 * @return vector of names
+	 */
+	private Vector<String> readNames(MethodHandle nameFunction) {
+		Vector<String> names = new Vector<String>();
+		try {
+			String name;
+			while ((name = toString((MemorySegment) nameFunction.invokeExact(this.table, names.size()))) != null) {
+				names.add(name);
+			}
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+		return names;
+	}
+
+	/**
+	 *
+	 */
+	public Vector<String> getInputNames() {
+		return this.readNames(this.tableInputName);
+	}
+
+	/**
+	 *
+	 */
+	public Vector<String> getOutputNames() {
+		return this.readNames(this.tableOutputName);
+	}
+
+	/**
+	 * Returns the representation of an output column.
+	 *
+	 * @param output index of the output
+	 * @return DENSE, SPARSE or RLE
+	 */
+	public int getRepresentation(int output) {
+		this.validateOutput(output);
+		try {
+			return (int) this.columnRepresentation.invokeExact(this.table, output);
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the raw buffer of an output column without copying it. Depending on
+	 * the representation, the 64 bit words are the dense bit vector (bit r % 64 of
+	 * word r / 64), the sorted ON-set rows or the pairwise [begin, end) runs of the
+	 * ON-set.
+	 *
+	 * @param output index of the output
+	 * @return read-only segment on the native buffer
+	 */
+	public MemorySegment getColumn(int output) {
+		this.validateOutput(output);
+		try (Arena arena = Arena.ofConfined()) {
+			MemorySegment length = arena.allocate(ValueLayout.JAVA_LONG);
+			MemorySegment data = (MemorySegment) this.columnData.invokeExact(this.table, output, length);
+			return this.segment(data, length.get(ValueLayout.JAVA_LONG, 0));
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns whether the function is incompletely specified, i.e. whether it has
+	 * care masks.
+	 *
+	 * @return true if some output is a don't care in some row
+	 */
+	public boolean hasCare() {
+		try {
+			return (int) this.tableHasCare.invokeExact(this.table) == 1;
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the representation of the care mask of an output.
+	 *
+	 * @param output index of the output
+	 * @return DENSE, SPARSE or RLE
+	 */
+	public int getCareRepresentation(int output) {
+		this.validateCareOutput(output);
+		try {
+			return (int) this.careColumnRepresentation.invokeExact(this.table, output);
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the raw buffer of the care mask of an output without copying it.
+	 * The mask has a cleared bit in every row where the output is a don't care,
+	 * the words follow the representation like those of getColumn.
+	 *
+	 * @param output index of the output
+	 * @return read-only segment on the native buffer
+	 */
+	public MemorySegment getCareColumn(int output) {
+		this.validateCareOutput(output);
+		try (Arena arena = Arena.ofConfined()) {
+			MemorySegment length = arena.allocate(ValueLayout.JAVA_LONG);
+			MemorySegment data = (MemorySegment) this.careColumnData.invokeExact(this.table, output, length);
+			return this.segment(data, length.get(ValueLayout.JAVA_LONG, 0));
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the packed column of an input without copying it. The input
+	 * columns are shared by all tables with the same number of inputs and use
+	 * the layout of the dense output columns.
+	 *
+	 * @param input index of the input
+	 * @return read-only segment on the native buffer
+	 */
+	public MemorySegment getInputColumn(int input) {
+		if (this.table.equals(MemorySegment.NULL)) {
+			throw new IllegalStateException("No benchmark file has been read!");
+		}
+		if (input < 0 || input >= this.getInputs()) {
+			throw new IndexOutOfBoundsException("Input index is out of range!");
+		}
+		try (Arena arena = Arena.ofConfined()) {
+			MemorySegment length = arena.allocate(ValueLayout.JAVA_LONG);
+			MemorySegment data = (MemorySegment) this.inputColumn.invokeExact(this.table, input, length);
+			if (data.equals(MemorySegment.NULL)) {
+				throw new RuntimeException(this.lastError());
+			}
+			return this.segment(data, length.get(ValueLayout.JAVA_LONG, 0));
+		} catch (RuntimeException e) {
+			throw e;
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the size of the ON-set of an output.
+	 *
+	 * @param output index of the output
+	 * @return number of rows where the output is 1
+	 */
+	public long countOnes(int output) {
+		this.validateOutput(output);
+		try {
+			return (long) this.columnCountOnes.invokeExact(this.table, output);
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns the value of an output at the given row.
+	 *
+	 * @param row    index of the row
+	 * @param output index of the output
+	 * @return 0 or 1
+	 */
+	public int getOutputAt(long row, int output) {
+		this.validateOutput(output);
+		try {
+			int value = (int) this.columnGet.invokeExact(this.table, output, row);
+			if (value < 0) {
+				throw new IndexOutOfBoundsException(this.lastError());
+			}
+			return value;
+		} catch (IndexOutOfBoundsException e) {
+			throw e;
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Returns whether an output is specified at the given row.
+	 *
+	 * @param row    index of the row
+	 * @param output index of the output
+	 * @return false if the output is a don't care in the row
+	 */
+	public boolean isCare(long row, int output) {
+		if (!this.hasCare()) {
+			this.validateOutput(output);
+			return true;
+		}
+		this.validateCareOutput(output);
+		try {
+			int value = (int) this.careColumnGet.invokeExact(this.table, output, row);
+			if (value < 0) {
+				throw new IndexOutOfBoundsException(this.lastError());
+			}
+			return value == 1;
+		} catch (IndexOutOfBoundsException e) {
+			throw e;
+		} catch (Throwable e) {
+			throw new RuntimeException(e);
+		}
+	}
+
+	/**
+	 * Releases the native table. Segments returned by getColumn, getCareColumn
+	 * and getInputColumn are invalidated first, so later accesses throw.
+	 */
+	@Override
+	public void close() {
+		if (this.arena != null) {
+			this.arena.close();
+			this.arena = null;
+		}
+		if (!this.table.equals(MemorySegment.NULL)) {
+			try {
+				this.tableFree.invokeExact(this.table);
+			} catch (Throwable e) {
+				throw new RuntimeException(e);
+			}
+			this.table = MemorySegment.NULL;
+		}
+	}
+
+	public static void main(String[] args) throws IOException {
+
+		try (NativeBenchmarkReader reader = new NativeBenchmarkReader(
+				"../../cplusplus/boolean-benchmark-interface/libbenchmark-interface.so")) {
+
+			reader.readFile("../test-data/add3.tt", true);
+
+			System.out.println("Model: " + reader.getModelName());
+			System.out.println("Inputs: " + reader.getInputs());
+			System.out.println("Outputs: " + reader.getOutputs());
+
+			for (int i = 0; i < reader.getOutputs(); i++) {
+				System.out.println("Output " + i + ": " + reader.countOnes(i) + " ones in "
+						+ reader.getColumn(i).byteSize() + " bytes");
+			}
+		}
+	}
+}
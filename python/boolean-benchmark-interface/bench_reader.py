@@ -0,0 +1,94 @@
+"""
+Timing driver of the Python interfaces for the cross-language throughput
+harness (harness/run_harness.py).
+
+Usage: python3 bench_reader.py <file.tt|file.pla> [--native]
+
+Prints one RESULT line with the seconds spent on reading the header, the body
+and the expansion, followed by the peak resident set size of the process in
+KiB. With --native, the file is read by the C++ reader through native_reader,
+which reads header and body in one call and does not expand the table.
+"""
+
+import sys
+import time
+from os import path
+
+import benchmark_reader
+import native_reader
+
+
+def peak_rss() -> int:
+    """
+    Returns the peak resident set size of the process in KiB (VmHWM).
+
+    :return: Peak RSS or 0 if /proc is not available
+    """
+    try:
+        with open('/proc/self/status') as f:
+            for line in f:
+                if line.startswith('VmHWM:'):
+                    return int(line.split()[1])
+    except OSError:
+        pass
+
+    return 0
+
+
+def bench_python(file_path: str) -> str:
+    """
+    Times the pure Python reader.
+
+    :param file_path: Path of the benchmark file
+    :return: RESULT line
+    """
+    filename, extension = path.splitext(file_path)
+
+    if extension.lower() != '.tt':
+        return "UNSUPPORTED"
+
+    reader = benchmark_reader.BenchmarkReader()
+
+    start = time.perf_counter()
+    reader.open_file(file_path)
+    reader.read_header()
+    header = time.perf_counter() - start
+
+    start = time.perf_counter()
+    reader.read_tt_file(file_path)
+    body = time.perf_counter() - start
+
+    return "RESULT header=%f body=%f expand=0 rows=%d rss=%d" % (header, body, reader.table.rows(), peak_rss())
+
+
+def bench_native(file_path: str) -> str:
+    """
+    Times the C++ reader used through the C ABI.
+
+    :param file_path: Path of the benchmark file
+    :return: RESULT line
+    """
+    native_reader.load_library()
+
+    start = time.perf_counter()
+    table = native_reader.NativeTable(file_path)
+    body = time.perf_counter() - start
+
+    rows = table.num_rows
+    rss = peak_rss()
+    table.close()
+
+    return "RESULT header=0 body=%f expand=0 rows=%d rss=%d" % (body, rows, rss)
+
+
+if __name__ == '__main__':
+    files = [arg for arg in sys.argv[1:] if not arg.startswith('--')]
+
+    if len(files) != 1:
+        print("Usage: python3 bench_reader.py <file.tt|file.pla> [--native]")
+        sys.exit(1)
+
+    if '--native' in sys.argv[1:]:
+        print(bench_native(files[0]))
+    else:
+        print(bench_python(files[0]))
@@ -0,0 +1,351 @@
+import ctypes
+import os
+import weakref
+from os import path
+
+# Column representations, see benchmark_c_api.h
+DENSE = 0
+SPARSE = 1
+RLE = 2
+
+# Load flags
+LOAD_DEFAULT = 0
+LOAD_DENSE = 1
+
+# Default location of the shared library built by the C++ Makefile
+DEFAULT_LIBRARY_PATH = path.join(path.dirname(path.abspath(__file__)), '..', '..',
+                                 'cplusplus', 'boolean-benchmark-interface',
+                                 'libbenchmark-interface.so')
+
+_library = None
+
+
+def load_library(library_path: str = None) -> ctypes.CDLL:
+    """
+    Loads the shared library of the C++ reader and declares the signatures of
+    the C ABI functions. The library is loaded once per process.
+
+    The path is taken from the argument, the environment variable
+    BENCHMARK_INTERFACE_LIBRARY or the default build location, in this order.
+
+    :param library_path: Optional path of the shared library
+    :return: Handle of the loaded library
+    """
+    global _library
+
+    if _library is not None:
+        return _library
+
+    if library_path is None:
+        library_path = os.environ.get('BENCHMARK_INTERFACE_LIBRARY', DEFAULT_LIBRARY_PATH)
+
+    lib = ctypes.CDLL(library_path)
+
+    table_p = ctypes.c_void_p
+
+    lib.bbi_abi_version.restype = ctypes.c_int
+    lib.bbi_last_error.restype = ctypes.c_char_p
+    lib.bbi_table_load.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(table_p)]
+    lib.bbi_table_load.restype = ctypes.c_int
+    lib.bbi_table_free.argtypes = [table_p]
+    lib.bbi_table_free.restype = None
+    lib.bbi_table_num_inputs.argtypes = [table_p]
+    lib.bbi_table_num_inputs.restype = ctypes.c_int
+    lib.bbi_table_num_outputs.argtypes = [table_p]
+    lib.bbi_table_num_outputs.restype = ctypes.c_int
+    lib.bbi_table_num_rows.argtypes = [table_p]
+    lib.bbi_table_num_rows.restype = ctypes.c_uint64
+    lib.bbi_table_model_name.argtypes = [table_p]
+    lib.bbi_table_model_name.restype = ctypes.c_char_p
+    lib.bbi_table_input_name.argtypes = [table_p, ctypes.c_int]
+    lib.bbi_table_input_name.restype = ctypes.c_char_p
+    lib.bbi_table_output_name.argtypes = [table_p, ctypes.c_int]
+    lib.bbi_table_output_name.restype = ctypes.c_char_p
+    lib.bbi_column_representation.argtypes = [table_p, ctypes.c_int]
+    lib.bbi_column_representation.restype = ctypes.c_int
+    lib.bbi_column_data.argtypes = [table_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint64)]
+    lib.bbi_column_data.restype = ctypes.POINTER(ctypes.c_uint64)
+    lib.bbi_column_count_ones.argtypes = [table_p, ctypes.c_int]
+    lib.bbi_column_count_ones.restype = ctypes.c_uint64
+    lib.bbi_column_get.argtypes = [table_p, ctypes.c_int, ctypes.c_uint64]
+    lib.bbi_column_get.restype = ctypes.c_int
+    lib.bbi_table_has_care.argtypes = [table_p]
+    lib.bbi_table_has_care.restype = ctypes.c_int
+    lib.bbi_care_column_representation.argtypes = [table_p, ctypes.c_int]
+    lib.bbi_care_column_representation.restype = ctypes.c_int
+    lib.bbi_care_column_data.argtypes = [table_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint64)]
+    lib.bbi_care_column_data.restype = ctypes.POINTER(ctypes.c_uint64)
+    lib.bbi_care_column_get.argtypes = [table_p, ctypes.c_int, ctypes.c_uint64]
+    lib.bbi_care_column_get.restype = ctypes.c_int
+    lib.bbi_input_column.argtypes = [table_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint64)]
+    lib.bbi_input_column.restype = ctypes.POINTER(ctypes.c_uint64)
+
+    _library = lib
+    return lib
+
+
+class NativeHandle:
+    """
+    Owner of a native table which frees it when the last reference is gone.
+
+    The table and every buffer exported from it hold a reference, so the
+    native memory stays valid as long as any view or slice of a buffer exists,
+    even after the table has been closed.
+    """
+
+    def __init__(self, lib: ctypes.CDLL, handle: ctypes.c_void_p):
+        weakref.finalize(self, lib.bbi_table_free, ctypes.c_void_p(handle.value))
+
+
+class NativeTable:
+    """
+    Truth table which is loaded by the C++ reader through the C ABI.
+
+    The packed output columns are exposed as memoryviews of unsigned 64 bit
+    words which point directly into the buffers of the C++ table. Each buffer
+    keeps the native table alive, so views and slices taken from them stay
+    valid after the table is closed. The native memory is freed once the
+    table is closed and all of its buffers are gone.
+
+    Incompletely specified functions (PLA types fd, fr and fdr) additionally
+    have a care mask per output, see has_care, care_column and is_care.
+    """
+
+    def __init__(self, file_path: str, dense: bool = False, library_path: str = None):
+        self.lib = load_library(library_path)
+        self.handle = ctypes.c_void_p()
+        self.owner = None
+
+        flags = LOAD_DENSE if dense else LOAD_DEFAULT
+
+        status = self.lib.bbi_table_load(file_path.encode(), flags, ctypes.byref(self.handle))
+
+        if status != 0:
+            raise Exception(self.lib.bbi_last_error().decode())
+
+        self.owner = NativeHandle(self.lib, self.handle)
+
+        self.num_inputs = self.lib.bbi_table_num_inputs(self.handle)
+        self.num_outputs = self.lib.bbi_table_num_outputs(self.handle)
+        self.num_rows = self.lib.bbi_table_num_rows(self.handle)
+        self.model_name = self.lib.bbi_table_model_name(self.handle).decode()
+        self.has_care = self.lib.bbi_table_has_care(self.handle) == 1
+
+        self.input_names = self.read_names(self.lib.bbi_table_input_name)
+        self.output_names = self.read_names(self.lib.bbi_table_output_name)
+
+    def read_names(self, func) -> list:
+        """
+        Collects the names returned by the given ABI function until it returns NULL.
+
+        :param func: bbi_table_input_name or bbi_table_output_name
+        :return: List of names
+        """
+        names = []
+        name = func(self.handle, 0)
+
+        while name is not None:
+            names.append(name.decode())
+            name = func(self.handle, len(names))
+
+        return names
+
+    def validate_output(self, output: int) -> None:
+        """
+        Validates the output index and the state of the handle.
+
+        :param output: Index of the output
+        :return: None
+        """
+        if not self.handle:
+            raise Exception("Table has been closed!")
+
+        if not 0 <= output < self.num_outputs:
+            raise Exception("Output index is out of range!")
+
+    def validate_care_output(self, output: int) -> None:
+        """
+        Validates the output index and that the table has care masks.
+
+        :param output: Index of the output
+        :return: None
+        """
+        self.validate_output(output)
+
+        if not self.has_care:
+            raise Exception("Table has no don't care rows!")
+
+    def wrap(self, pointer, length: int) -> memoryview:
+        """
+        Wraps a native buffer of the table without copying it.
+
+        The buffer holds a reference to the owner of the native table, which
+        is inherited by every view and slice of it.
+
+        :param pointer: Pointer to the first word
+        :param length: Number of words
+        :return: Memoryview of format 'Q' on the native buffer
+        """
+        if length == 0:
+            return memoryview(b'').cast('Q')
+
+        buffer = (ctypes.c_uint64 * length).from_address(ctypes.addressof(pointer.contents))
+        buffer.owner = self.owner
+
+        return memoryview(buffer).cast('B').cast('Q')
+
+    def representation(self, output: int) -> int:
+        """
+        Returns the representation of an output column (DENSE, SPARSE or RLE).
+
+        :param output: Index of the output
+        :return: Representation constant
+        """
+        self.validate_output(output)
+        return self.lib.bbi_column_representation(self.handle, output)
+
+    def column(self, output: int) -> memoryview:
+        """
+        Returns the raw buffer of an output column without copying it.
+
+        Depending on the representation, the words are the dense bit vector
+        (bit r % 64 of word r // 64), the sorted ON-set rows or the pairwise
+        [begin, end) runs of the ON-set.
+
+        :param output: Index of the output
+        :return: Memoryview of format 'Q' on the native buffer
+        """
+        self.validate_output(output)
+
+        length = ctypes.c_uint64()
+        pointer = self.lib.bbi_column_data(self.handle, output, ctypes.byref(length))
+
+        return self.wrap(pointer, length.value)
+
+    def care_representation(self, output: int) -> int:
+        """
+        Returns the representation of the care mask of an output.
+
+        :param output: Index of the output
+        :return: Representation constant
+        """
+        self.validate_care_output(output)
+        return self.lib.bbi_care_column_representation(self.handle, output)
+
+    def care_column(self, output: int) -> memoryview:
+        """
+        Returns the raw buffer of the care mask of an output without copying it.
+
+        The mask has a cleared bit in every row where the output is a don't
+        care, the words follow the representation like those of column().
+
+        :param output: Index of the output
+        :return: Memoryview of format 'Q' on the native buffer
+        """
+        self.validate_care_output(output)
+
+        length = ctypes.c_uint64()
+        pointer = self.lib.bbi_care_column_data(self.handle, output, ctypes.byref(length))
+
+        return self.wrap(pointer, length.value)
+
+    def input_column(self, input: int) -> memoryview:
+        """
+        Returns the packed column of an input without copying it.
+
+        The input columns are shared by all tables with the same number of
+        inputs, bit r % 64 of word r // 64 is the value of the input in row r.
+
+        :param input: Index of the input
+        :return: Memoryview of format 'Q' on the native buffer
+        """
+        if not self.handle:
+            raise Exception("Table has been closed!")
+
+        if not 0 <= input < self.num_inputs:
+            raise Exception("Input index is out of range!")
+
+        length = ctypes.c_uint64()
+        pointer = self.lib.bbi_input_column(self.handle, input, ctypes.byref(length))
+
+        if not pointer:
+            raise Exception(self.lib.bbi_last_error().decode())
+
+        return self.wrap(pointer, length.value)
+
+    def count_ones(self, output: int) -> int:
+        """
+        Returns the size of the ON-set of an output.
+
+        :param output: Index of the output
+        :return: Number of rows where the output is 1
+        """
+        self.validate_output(output)
+        return self.lib.bbi_column_count_ones(self.handle, output)
+
+    def get(self, row: int, output: int) -> int:
+        """
+        Returns the value of an output at the given row.
+
+        :param row: Index of the row
+        :param output: Index of the output
+        :return: 0 or 1
+        """
+        self.validate_output(output)
+
+        value = self.lib.bbi_column_get(self.handle, output, row)
+
+        if value < 0:
+            raise Exception(self.lib.bbi_last_error().decode())
+
+        return value
+
+    def is_care(self, row: int, output: int) -> bool:
+        """
+        Returns whether an output is specified at the given row.
+
+        :param row: Index of the row
+        :param output: Index of the output
+        :return: False if the output is a don't care in the row
+        """
+        if not self.has_care:
+            self.validate_output(output)
+            return True
+
+        self.validate_care_output(output)
+
+        value = self.lib.bbi_care_column_get(self.handle, output, row)
+
+        if value < 0:
+            raise Exception(self.lib.bbi_last_error().decode())
+
+        return value == 1
+
+    def get_outputs_at(self, row: int) -> list:
+        """
+        Returns a row of outputs at a specific index.
+
+        :param row: Index of the row
+        :return: List of output values
+        """
+        return [self.get(row, output) for output in range(self.num_outputs)]
+
+    def close(self) -> None:
+        """
+        Closes the table. The native table is freed as soon as no buffer
+        returned by column(), care_column() or input_column() is referenced.
+
+        :return: None
+        """
+        self.handle = ctypes.c_void_p()
+        self.owner = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def __del__(self):
+        if getattr(self, 'handle', None):
+            self.close()